@@ -0,0 +1,47 @@
+#include "Bench.h"
+
+#include <iostream>
+
+volatile float benchSink;
+
+std::string benchFilter;
+
+static std::vector<BenchResult> results;
+
+bool BenchEnabled(const char* name) {
+    return benchFilter.empty() || std::string(name).find(benchFilter) != std::string::npos;
+}
+
+PerfCounters& Counters() {
+    static PerfCounters counters;
+    return counters;
+}
+
+void RecordResult(const BenchResult& result) {
+    results.push_back(result);
+    std::cerr << result.name << ": " << (result.seconds / result.ops * 1e9) << " ns/op" << std::endl;
+}
+
+void WriteReport(std::ostream& out) {
+    out << "{\n  \"counters\": " << (Counters().Available() ? "true" : "false") << ",\n  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << (i ? "," : "") << "\n    {\"name\": \"" << r.name << "\""
+            << ", \"ops\": " << r.ops
+            << ", \"seconds\": " << r.seconds
+            << ", \"ns_per_op\": " << (r.seconds / r.ops * 1e9)
+            << ", \"ops_per_sec\": " << (r.ops / r.seconds);
+
+        for (int c = 0; c < PerfCounters::COUNTER_COUNT; c++) {
+            out << ", \"" << PerfCounters::Name((PerfCounters::Counter)c) << "_per_op\": ";
+            if (Counters().Available((PerfCounters::Counter)c))
+                out << (r.counters[c] / r.ops);
+            else
+                out << "null";
+        }
+        out << "}";
+    }
+
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <limits>
+
+#include "PerfCounters.h"
+#include "Timing.h"
+
+const int benchRepeats = 5; // the fastest run is the one reported
+
+struct BenchResult {
+    std::string name;
+    double ops; // work done by one run, whatever unit the benchmark counts in
+    double seconds;
+    unsigned long long counters[PerfCounters::COUNTER_COUNT];
+};
+
+// written by benchmarks so the compiler can't throw their work away
+extern volatile float benchSink;
+
+inline void Keep(float value) {
+    benchSink = value;
+}
+
+// only benchmarks whose name contains this get run
+extern std::string benchFilter;
+
+bool BenchEnabled(const char* name);
+
+PerfCounters& Counters();
+
+void RecordResult(const BenchResult& result);
+
+// writes every recorded result as json
+void WriteReport(std::ostream& out);
+
+// body does one run and returns how many ops it did
+template <typename F>
+void Bench(const char* name, F body) {
+    if (!BenchEnabled(name))
+        return;
+
+    body(); // warm up caches and branch predictors
+
+    BenchResult best;
+    best.name = name;
+    best.seconds = std::numeric_limits<double>::max();
+
+    for (int i = 0; i < benchRepeats; i++) {
+        Counters().Start();
+        double begin = Now();
+        double ops = body();
+        double seconds = Now() - begin;
+        Counters().Stop();
+
+        if (seconds < best.seconds) {
+            best.ops = ops;
+            best.seconds = seconds;
+            for (int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+                best.counters[c] = Counters().Value((PerfCounters::Counter)c);
+        }
+    }
+
+    RecordResult(best);
+}
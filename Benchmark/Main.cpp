@@ -0,0 +1,524 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+#include "Bench.h"
+#include "Match.h"
+#include "Batch.h"
+#include "Paddle.h"
+#include "Policies.h"
+#include "SoftRaster.h"
+#include "JobSystem.h"
+#include "EntityStore.h"
+#include "Systems.h"
+#include "Collision.h"
+#include "Arena.h"
+#include "Mlp.h"
+#include "NeuralPolicy.h"
+#include "Search.h"
+
+// states recorded from a real match so the collision and bot benchmarks see realistic positions
+static std::vector<MatchState> RecordStates(size_t count) {
+    std::vector<MatchState> states;
+    MatchState state;
+    InitMatch(state, 1);
+    while (states.size() < count) {
+        TickMatch(state, 0.0f);
+        if (state.timer > 100) // skip the pause before each serve
+            states.push_back(state);
+    }
+    return states;
+}
+
+static void MatchBenchmarks() {
+    const std::vector<MatchState> recorded = RecordStates(4096);
+
+    Bench("tick", []() {
+        MatchState state;
+        InitMatch(state, 1);
+        for (int i = 0; i < 1000000; i++)
+            TickMatch(state, 0.0f);
+        Keep(state.positions[8]);
+        return 1000000.0;
+    });
+
+    Bench("rect_collision", [&]() {
+        int hits = 0;
+        for (int n = 0; n < 256; n++) {
+            for (const MatchState& s : recorded)
+                hits += RectCollision(s.positions[0], s.positions[1], s.positions[4], s.positions[5], s.positions[8], s.positions[9]);
+        }
+        Keep((float)hits);
+        return 256.0 * recorded.size();
+    });
+
+    Bench("player1_collision", [&]() {
+        int hits = 0;
+        for (int n = 0; n < 256; n++) {
+            for (const MatchState& s : recorded)
+                hits += Player1Collision(s.positions);
+        }
+        Keep((float)hits);
+        return 256.0 * recorded.size();
+    });
+
+    Bench("bot_step", [&]() {
+        std::vector<MatchState> states = recorded;
+        for (int n = 0; n < 256; n++) {
+            for (MatchState& s : states)
+                BotStep(s);
+        }
+        Keep(states[0].positions[25]);
+        return 256.0 * states.size();
+    });
+
+    Bench("oob_reset", []() {
+        MatchState state;
+        InitMatch(state, 1);
+        for (int i = 0; i < 1000000; i++)
+            ResetRound(state);
+        Keep(state.ballAngle);
+        return 1000000.0;
+    });
+
+    // ops are whole matches here
+    Bench("full_match", []() {
+        unsigned long long ticks = 0;
+        for (unsigned int i = 0; i < 20; i++) {
+            MatchState state;
+            InitMatch(state, i);
+            while (!MatchOver(state))
+                TickMatch(state, 0.0f);
+            ticks += state.ticks;
+        }
+        Keep((float)ticks);
+        return 20.0;
+    });
+
+    // ops are match ticks
+    Bench("batch_ticks", []() {
+        std::vector<MatchState> matches;
+        InitBatch(matches, 64, 1);
+        return (double)PlayBatch(matches);
+    });
+}
+
+// the runtime polymorphic version of Match's policies, only here as the baseline for the templates
+struct VirtualPolicy {
+    virtual ~VirtualPolicy() {}
+    virtual void Move(MatchState& state, MatchSide side) = 0;
+};
+
+template <typename Policy>
+struct VirtualAdapter : VirtualPolicy {
+    Policy policy;
+    void Move(MatchState& state, MatchSide side) override { policy.Move(state, side); }
+};
+
+struct VirtualMatch {
+    MatchState state;
+    VirtualPolicy* left;
+    VirtualPolicy* right;
+};
+
+static void TickVirtual(VirtualMatch& match) {
+    match.left->Move(match.state, SIDE_LEFT);
+    ClampPaddle(match.state, SIDE_LEFT);
+    match.right->Move(match.state, SIDE_RIGHT);
+    ClampPaddle(match.state, SIDE_RIGHT);
+    TickBall(match.state);
+}
+
+// predictive against tracking both ways, ops are match ticks for the whole matches and paddle moves for the move loops
+static void PolicyBenchmarks() {
+    VirtualAdapter<TrackingPolicy> tracking;
+    VirtualAdapter<PredictivePolicy> predictive;
+
+    // picked through a volatile so the compiler can't see which class it is and devirtualize the calls
+    VirtualPolicy* policies[2] = { &predictive, &tracking };
+    volatile int leftIndex = 0;
+    VirtualPolicy* left = policies[leftIndex];
+    VirtualPolicy* right = policies[1 - leftIndex];
+
+    Bench("policy_batch_template", []() {
+        std::vector<Match<PredictivePolicy, TrackingPolicy>> matches;
+        InitBatch(matches, 16, 1);
+        return (double)PlayBatch(matches);
+    });
+
+    Bench("policy_batch_virtual", [&]() {
+        std::vector<VirtualMatch> matches(16);
+        unsigned long long ticks = 0;
+        for (size_t i = 0; i < matches.size(); i++) {
+            InitMatch(matches[i].state, BatchSeed(1, i));
+            matches[i].left = left;
+            matches[i].right = right;
+            while (!MatchOver(matches[i].state)) {
+                TickVirtual(matches[i]);
+                ticks++;
+            }
+        }
+        return (double)ticks;
+    });
+
+    // just the controllers, where the call itself is a bigger share of the work
+    const std::vector<MatchState> recorded = RecordStates(4096);
+
+    Bench("policy_move_template", [&]() {
+        std::vector<MatchState> states = recorded;
+        PredictivePolicy leftPolicy;
+        TrackingPolicy rightPolicy;
+        for (int n = 0; n < 64; n++) {
+            for (MatchState& s : states) {
+                leftPolicy.Move(s, SIDE_LEFT);
+                rightPolicy.Move(s, SIDE_RIGHT);
+            }
+        }
+        Keep(states[0].positions[25]);
+        return 2.0 * 64 * states.size();
+    });
+
+    Bench("policy_move_virtual", [&]() {
+        std::vector<MatchState> states = recorded;
+        for (int n = 0; n < 64; n++) {
+            for (MatchState& s : states) {
+                left->Move(s, SIDE_LEFT);
+                right->Move(s, SIDE_RIGHT);
+            }
+        }
+        Keep(states[0].positions[25]);
+        return 2.0 * 64 * states.size();
+    });
+}
+
+// ops are paddle moves, wants are big enough that the old loop has to take many steps
+static void PaddleBenchmarks() {
+    std::vector<float> wants(4096);
+    MatchState random;
+    random.seed = 1;
+    for (float& want : wants)
+        want = (MatchRand(random) / 32767.0f - 0.5f) * 4.0f; // up to two screens, like a stalled frame catching up
+
+    // the clamp loops TickMatch used to run, as the baseline
+    Bench("paddle_clamp_loop", [&]() {
+        float bottom = -0.2f, top = 0.2f;
+        for (float want : wants) {
+            bottom += want;
+            top += want;
+            while (top > 1.0f) {
+                bottom -= 0.01f;
+                top -= 0.01f;
+            }
+            while (bottom < -1.0f) {
+                bottom += 0.01f;
+                top += 0.01f;
+            }
+        }
+        Keep(bottom);
+        return (double)wants.size();
+    });
+
+    Bench("paddle_clamp_snapped", [&]() {
+        float bottom = -0.2f, top = 0.2f;
+        for (float want : wants) {
+            bottom += want;
+            top += want;
+            float shift = SnappedCorrection(bottom, top, -1.0f, 1.0f, 0.01f);
+            bottom += shift;
+            top += shift;
+        }
+        Keep(bottom);
+        return (double)wants.size();
+    });
+
+    PaddleController controller = MakePaddleController(-1.0f, 1.0f, 0.05f, 0.005f);
+    Bench("paddle_step", [&]() {
+        float bottom = -0.2f, top = 0.2f;
+        for (float want : wants) {
+            float move = StepPaddle(controller, bottom, top, want);
+            bottom += move;
+            top += move;
+        }
+        Keep(bottom);
+        return (double)wants.size();
+    });
+}
+
+// ops are frames
+static void RasterBenchmarks() {
+    const std::vector<MatchState> recorded = RecordStates(1024);
+    std::vector<unsigned char> pixels(RasterFrameBytes(160, 90, RASTER_RGB) * recorded.size());
+
+    Bench("raster_gray_84", [&]() {
+        for (const MatchState& s : recorded)
+            RasterizeMatch(s.positions, 84, 84, RASTER_GRAY, pixels.data());
+        Keep(pixels[0]);
+        return (double)recorded.size();
+    });
+
+    Bench("raster_rgb_160x90", [&]() {
+        for (const MatchState& s : recorded)
+            RasterizeMatch(s.positions, 160, 90, RASTER_RGB, pixels.data());
+        Keep(pixels[0]);
+        return (double)recorded.size();
+    });
+
+    // every frame gets its own buffer like a training batch would
+    JobSystem jobs;
+
+    Bench("raster_batch_gray_84", [&]() {
+        RasterizeBatch(jobs, recorded, 84, 84, RASTER_GRAY, pixels.data());
+        Keep(pixels[0]);
+        return (double)recorded.size();
+    });
+
+    Bench("raster_batch_rgb_160x90", [&]() {
+        RasterizeBatch(jobs, recorded, 160, 90, RASTER_RGB, pixels.data());
+        Keep(pixels[0]);
+        return (double)recorded.size();
+    });
+}
+
+// a store with a few paddles and lots of balls spread over the screen
+static void FillEntities(EntityStore& store, unsigned int balls) {
+    MatchState random;
+    random.seed = 1;
+    SpawnPaddle(store, -0.97f);
+    SpawnPaddle(store, 0.97f);
+    for (unsigned int i = 0; i < balls; i++) {
+        float x = MatchRand(random) / 16383.5f - 1.0f;
+        float y = MatchRand(random) / 16383.5f - 1.0f;
+        SpawnBall(store, x, y, MatchRand(random) / 5215.0f, 0.005f);
+    }
+}
+
+// ops are entities processed
+static void EntityBenchmarks() {
+    EntityStore store;
+    FillEntities(store, 100000);
+
+    Bench("entity_integrate", [&]() {
+        for (int n = 0; n < 16; n++)
+            IntegrateSystem(store);
+        Keep(store.x[2]);
+        return 16.0 * EntityCount(store);
+    });
+
+    Bench("entity_walls", [&]() {
+        for (int n = 0; n < 16; n++)
+            WallSystem(store);
+        Keep(store.vy[2]);
+        return 16.0 * EntityCount(store);
+    });
+
+    PaddleScratch scratch;
+    Bench("entity_paddles", [&]() {
+        unsigned int hits = 0;
+        for (int n = 0; n < 16; n++)
+            hits += PaddleSystem(store, 0.0f, scratch);
+        Keep((float)hits);
+        return 16.0 * EntityCount(store);
+    });
+}
+
+// ops are circle-box tests, every ball against both paddles
+static void CollisionBenchmarks() {
+    EntityStore store;
+    FillEntities(store, 100000);
+    const size_t count = EntityCount(store);
+    const CircleArrays circles = { store.x.data(), store.y.data(), store.halfWidth.data(), count };
+    const BoxArrays boxes = { store.x.data(), store.y.data(), store.halfWidth.data(), store.halfHeight.data(), 2 }; // the paddles are spawned first
+
+    const CollisionKernel kernels[] = { COLLISION_SCALAR, COLLISION_SSE41, COLLISION_AVX2 };
+    const char* names[] = { "collide_scalar", "collide_sse41", "collide_avx2" };
+    std::vector<BoxContact> contacts;
+    for (int k = 0; k < 3; k++) {
+        UseCollisionKernel(kernels[k]);
+        if (ActiveCollisionKernel() != kernels[k])
+            continue;
+
+        Bench(names[k], [&]() {
+            for (int n = 0; n < 16; n++) {
+                contacts.clear();
+                CollideCirclesBoxes(circles, boxes, contacts);
+            }
+            Keep((float)contacts.size());
+            return 16.0 * count * boxes.count;
+        });
+    }
+    UseCollisionKernel(BestCollisionKernel());
+}
+
+// ops are ball ticks, so ns_per_op is the cost of one ball for one tick
+static void ArenaBenchmarks() {
+    const unsigned int counts[] = { 10, 100, 1000, 10000, 100000 };
+    const char* names[] = { "arena_10", "arena_100", "arena_1000", "arena_10000", "arena_100000" };
+
+    for (int c = 0; c < 5; c++) {
+        const unsigned int balls = counts[c];
+        const unsigned int ticks = balls >= 10000 ? 10 : 1000;
+
+        Arena arena;
+        InitArena(arena, balls, 1);
+        TickArena(arena, 0.0f); // the first tick sorts from scratch
+
+        Bench(names[c], [&]() {
+            for (unsigned int t = 0; t < ticks; t++)
+                TickArena(arena, 0.0f);
+            Keep((float)arena.bounces);
+            return (double)balls * ticks;
+        });
+    }
+}
+
+// one broadphase update on a settled arena, ops are balls so the sizes compare per ball
+static void BroadphaseBenchmarks() {
+    const unsigned int counts[] = { 100, 1000, 10000, 100000 };
+    const char* gridNames[] = { "grid_100", "grid_1000", "grid_10000", "grid_100000" };
+    const char* sweepNames[] = { "sweep_100", "sweep_1000", "sweep_10000", "sweep_100000" };
+    const char* bruteNames[] = { "brute_100", "brute_1000", "brute_10000" };
+
+    for (int c = 0; c < 4; c++) {
+        const unsigned int balls = counts[c];
+        const unsigned int updates = balls >= 10000 ? 10 : 1000;
+
+        Arena arena;
+        InitArena(arena, balls, 1);
+        for (int t = 0; t < 60; t++)
+            TickArena(arena, 0.0f);
+
+        UniformGrid grid;
+        Bench(gridNames[c], [&]() {
+            for (unsigned int u = 0; u < updates; u++)
+                grid.Update(arena.store);
+            Keep((float)grid.Pairs().size());
+            return (double)balls * updates;
+        });
+
+        // the store doesn't move between updates so this is the sweep's best case, nothing to re-sort
+        SweepAndPrune sweep;
+        sweep.Update(arena.store);
+        Bench(sweepNames[c], [&]() {
+            for (unsigned int u = 0; u < updates; u++)
+                sweep.Update(arena.store);
+            Keep((float)sweep.Pairs().size());
+            return (double)balls * updates;
+        });
+
+        if (c < 3) {
+            std::vector<CollisionPair> pairs;
+            Bench(bruteNames[c], [&]() {
+                const unsigned int runs = balls >= 10000 ? 1 : updates / 10;
+                for (unsigned int u = 0; u < runs; u++)
+                    BruteForcePairs(arena.store, pairs);
+                Keep((float)pairs.size());
+                return (double)balls * runs;
+            });
+        }
+    }
+}
+
+// ops are network rows, one observation through a 7-32-32-1 policy network
+static void MlpBenchmarks() {
+    Mlp mlp;
+    InitMlp(mlp, { observationCount, 32, 32, 1 }, 1);
+
+    std::vector<MatchState> states = RecordStates(1000);
+    std::vector<float> observations(states.size() * observationCount);
+    for (size_t i = 0; i < states.size(); i++)
+        Observe(states[i], SIDE_LEFT, &observations[i * observationCount]);
+    std::vector<float> outputs(states.size());
+    MlpScratch scratch;
+
+    const MlpKernel kernels[] = { MLP_SCALAR, MLP_AVX2 };
+    const char* names[] = { "mlp_gemm_scalar", "mlp_gemm_avx2" };
+    for (int k = 0; k < 2; k++) {
+        UseMlpKernel(kernels[k]);
+        if (ActiveMlpKernel() != kernels[k])
+            continue;
+
+        Bench(names[k], [&]() {
+            for (int n = 0; n < 16; n++)
+                RunMlp(mlp, observations.data(), states.size(), outputs.data(), scratch);
+            Keep(outputs[0]);
+            return 16.0 * states.size();
+        });
+    }
+    UseMlpKernel(BestMlpKernel());
+
+    // ops are policy steps, a network move plus the match tick it's for, so ops_per_sec is policy steps a second
+    const char* policyNames[] = { "mlp_policy_fp32", "mlp_policy_int8" };
+    for (int q = 0; q < 2; q++) {
+        if (q == 1)
+            QuantizeMlp(mlp);
+
+        Bench(policyNames[q], [&]() {
+            std::vector<Match<NeuralPolicy, TrackingPolicy>> matches;
+            InitBatch(matches, 1000, 1);
+            NeuralBatch batch;
+            size_t steps = 0;
+            for (int tick = 0; tick < 256; tick++) {
+                DecideNeural(matches, &Match<NeuralPolicy, TrackingPolicy>::left, SIDE_LEFT, mlp, batch);
+                steps += TickBatch(matches);
+            }
+            Keep(matches[0].state.positions[1]);
+            return (double)steps;
+        });
+    }
+}
+
+// ops are simulations, a copy of the match played down the tree and rolled out, one thread so ops_per_sec is simulations a second per core
+static void SearchBenchmarks() {
+    const std::vector<MatchState> recorded = RecordStates(256);
+
+    // a fixed number of simulations instead of a time budget so every run does the same work
+    SearchOptions options;
+    options.budget = 0.0;
+    options.maxSimulations = 256;
+    SearchBot bot;
+    InitSearchBot(bot, options);
+
+    Bench("search_simulation", [&]() {
+        float vert = 0.0f;
+        for (size_t i = 0; i < recorded.size(); i += 16)
+            vert += SearchMove(bot, recorded[i], SIDE_RIGHT);
+        Keep(vert);
+        return (double)options.maxSimulations * ((recorded.size() + 15) / 16);
+    });
+}
+
+int main(int argc, char** argv)
+{
+    const char* outPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            outPath = argv[++i];
+        else
+            benchFilter = argv[i];
+    }
+
+    if (!Counters().Available())
+        std::cerr << "Hardware counters unavailable, only reporting times" << std::endl;
+
+    MatchBenchmarks();
+    PaddleBenchmarks();
+    PolicyBenchmarks();
+    RasterBenchmarks();
+    EntityBenchmarks();
+    CollisionBenchmarks();
+    ArenaBenchmarks();
+    BroadphaseBenchmarks();
+    MlpBenchmarks();
+    SearchBenchmarks();
+
+    if (outPath) {
+        std::ofstream out(outPath);
+        WriteReport(out);
+    }
+    else {
+        WriteReport(std::cout);
+    }
+    return 0;
+}
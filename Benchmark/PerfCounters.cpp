@@ -0,0 +1,86 @@
+#include "PerfCounters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+
+static int OpenCounter(unsigned int type, unsigned long long config, int group) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group == -1 ? 1 : 0; // the group leader starts and stops everyone
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+#endif
+
+PerfCounters::PerfCounters() {
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        m_Fds[i] = -1;
+        m_Available[i] = false;
+        m_Values[i] = 0;
+    }
+
+#ifdef __linux__
+    const unsigned long long configs[COUNTER_COUNT] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_BRANCH_MISSES,
+        PERF_COUNT_HW_CACHE_MISSES
+    };
+
+    m_Fds[CYCLES] = OpenCounter(PERF_TYPE_HARDWARE, configs[CYCLES], -1);
+    if (m_Fds[CYCLES] == -1)
+        return;
+    m_Available[CYCLES] = true;
+
+    for (int i = 1; i < COUNTER_COUNT; i++) {
+        m_Fds[i] = OpenCounter(PERF_TYPE_HARDWARE, configs[i], m_Fds[CYCLES]);
+        m_Available[i] = m_Fds[i] != -1;
+    }
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        if (m_Fds[i] != -1)
+            close(m_Fds[i]);
+    }
+#endif
+}
+
+void PerfCounters::Start() {
+#ifdef __linux__
+    if (!Available())
+        return;
+    ioctl(m_Fds[CYCLES], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(m_Fds[CYCLES], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+void PerfCounters::Stop() {
+#ifdef __linux__
+    if (!Available())
+        return;
+    ioctl(m_Fds[CYCLES], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    for (int i = 0; i < COUNTER_COUNT; i++) {
+        unsigned long long value = 0;
+        if (m_Available[i] && read(m_Fds[i], &value, sizeof(value)) == sizeof(value))
+            m_Values[i] = value;
+        else
+            m_Values[i] = 0;
+    }
+#endif
+}
+
+const char* PerfCounters::Name(Counter counter) {
+    static const char* names[COUNTER_COUNT] = { "cycles", "instructions", "branch_misses", "cache_misses" };
+    return names[counter];
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+// hardware counters through perf_event_open, only on linux and only where perf_event_paranoid allows it
+// everywhere else Available() is false and the benchmarks just report times
+class PerfCounters {
+public:
+    enum Counter {
+        CYCLES,
+        INSTRUCTIONS,
+        BRANCH_MISSES,
+        CACHE_MISSES,
+        COUNTER_COUNT
+    };
+
+    PerfCounters();
+    ~PerfCounters();
+
+    bool Available() const { return m_Available[CYCLES]; }
+    bool Available(Counter counter) const { return m_Available[counter]; }
+
+    void Start();
+    void Stop();
+
+    // counts between the last Start and Stop
+    unsigned long long Value(Counter counter) const { return m_Values[counter]; }
+
+    static const char* Name(Counter counter);
+
+private:
+    int m_Fds[COUNTER_COUNT];
+    bool m_Available[COUNTER_COUNT];
+    unsigned long long m_Values[COUNTER_COUNT];
+};
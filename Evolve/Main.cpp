@@ -0,0 +1,117 @@
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+
+#include "Evolve.h"
+#include "JobSystem.h"
+#include "Mlp.h"
+#include "NeuralPolicy.h"
+#include "Timing.h"
+
+// tunes the bot's constants against an opponent, checkpointing every generation so a long run can be picked up again, e.g.
+//     Evolve --generations 200 --population 128 --opponent predictive --checkpoint bots/predictive.evo
+static void PrintUsage() {
+    std::cout << "Usage: Evolve [--generations n] [--population n] [--elites n] [--matches n] [--ticks n] [--mutation f] "
+        "[--seed n] [--threads n] [--opponent idle|tracking|predictive|network.mlp] [--checkpoint path] [--resume]" << std::endl;
+}
+
+static void PrintParams(const BotParams& params) {
+    for (unsigned int i = 0; i < botParamCount; i++)
+        std::cout << (i == 0 ? "" : " ") << botParamRanges[i].name << " " << params.*botParamRanges[i].member;
+}
+
+int main(int argc, char** argv)
+{
+    EvolveOptions options;
+    unsigned int generations = 50;
+    unsigned int threads = 0;
+    const char* opponentName = "tracking";
+    const char* checkpoint = "evolve.evo";
+    bool resume = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--generations") == 0 && i + 1 < argc)
+            generations = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--population") == 0 && i + 1 < argc)
+            options.population = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--elites") == 0 && i + 1 < argc)
+            options.elites = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--matches") == 0 && i + 1 < argc)
+            options.matches = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+            options.maxTicks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--mutation") == 0 && i + 1 < argc)
+            options.mutation = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            options.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--opponent") == 0 && i + 1 < argc)
+            opponentName = argv[++i];
+        else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc)
+            checkpoint = argv[++i];
+        else if (strcmp(argv[i], "--resume") == 0)
+            resume = true;
+        else {
+            std::cout << "Unknown option " << argv[i] << std::endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    Mlp network;
+    Entrant opponent;
+    opponent.name = opponentName;
+    if (!ParsePolicyKind(opponentName, opponent.kind)) {
+        if (!LoadMlp(opponentName, network))
+            return 1;
+        if (MlpInputs(network) != observationCount || MlpOutputs(network) != 1) {
+            std::cout << opponentName << " doesn't take " << observationCount << " observations to one move" << std::endl;
+            return 1;
+        }
+        opponent.kind = POLICY_NEURAL;
+        opponent.mlp = &network;
+    }
+
+    // a checkpoint holds a generation that's already been played, so carry on from its children
+    Evolution evolution;
+    if (resume) {
+        if (!LoadEvolution(checkpoint, evolution))
+            return 1;
+        NextGeneration(evolution, options);
+    }
+    else {
+        InitEvolution(evolution, options);
+    }
+
+    if (evolution.population.empty()) {
+        std::cout << "Nothing to evolve, the population is empty" << std::endl;
+        return 1;
+    }
+
+    JobSystem jobs(threads);
+    std::cout << "[Evolve] " << evolution.population.size() << " bots against " << opponent.name << ", " << options.matches
+        << " matches of up to " << options.maxTicks << " ticks each a generation on " << jobs.ThreadCount() << " threads" << std::endl;
+
+    while (evolution.generation < generations) {
+        double begin = Now();
+        size_t matches = EvaluatePopulation(evolution, opponent, options, jobs);
+        double seconds = Now() - begin;
+
+        double mean = 0.0;
+        for (const Individual& individual : evolution.population)
+            mean += individual.fitness / evolution.population.size();
+
+        const Individual& best = evolution.population.front();
+        std::cout << "[Evolve] generation " << evolution.generation << ": best " << best.fitness << " mean " << mean << " points a match, "
+            << matches << " matches in " << seconds << "s (" << (seconds > 0.0 ? matches / seconds * 60.0 : 0.0) << " matches/min)" << std::endl;
+        std::cout << "    ";
+        PrintParams(best.params);
+        std::cout << std::endl;
+
+        if (!SaveEvolution(checkpoint, evolution))
+            return 1;
+        NextGeneration(evolution, options);
+    }
+    return 0;
+}
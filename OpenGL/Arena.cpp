@@ -0,0 +1,89 @@
+#include "Arena.h"
+
+#include <cmath>
+
+#include "Match.h"
+#include "Systems.h"
+
+float ArenaBallRadius(unsigned int balls) {
+    // keep the balls covering about a quarter of the screen at most
+    const float coverage = 0.25f;
+    float radius = std::sqrt(coverage * 4.0f / ((float)pi * worldAspect * (balls ? balls : 1)));
+    return radius < size ? radius : size;
+}
+
+// puts a ball back in the middle heading at a random side, angles stay within 45 degrees of flat like InitMatch
+static void Serve(Arena& arena, Entity ball) {
+    unsigned int slot = EntitySlot(arena.store, ball);
+    float angle = (float)(3 * pi / 4 + LcgRand(arena.seed) / 32767.0 * (pi / 2));
+    if (LcgRand(arena.seed) & 1)
+        angle = (float)pi - angle;
+
+    arena.store.x[slot] = 0.0f;
+    arena.store.y[slot] = LcgRand(arena.seed) / 32767.0f * 1.6f - 0.8f;
+    arena.store.vx[slot] = std::cos(angle) * 0.005f;
+    arena.store.vy[slot] = std::sin(angle) * 0.005f;
+}
+
+void InitArena(Arena& arena, unsigned int balls, unsigned int seed, ArenaBroadphase broadphase) {
+    ClearEntities(arena.store);
+    arena.broadphase = broadphase;
+    arena.sweep = SweepAndPrune();
+    arena.seed = seed;
+    arena.score[0] = 0;
+    arena.score[1] = 0;
+    arena.ticks = 0;
+    arena.bounces = 0;
+    arena.ballRadius = ArenaBallRadius(balls);
+
+    arena.paddles[0] = SpawnPaddle(arena.store, -0.97f);
+    arena.player = MakePaddleController(-1.0f, 1.0f, paddleStepSize);
+    arena.paddles[1] = SpawnPaddle(arena.store, 0.97f);
+
+    for (unsigned int i = 0; i < balls; i++) {
+        Entity ball = SpawnBall(arena.store, 0.0f, 0.0f, 0.0f, 0.0f);
+        SetCircleCollider(arena.store, ball, arena.ballRadius);
+        Serve(arena, ball);
+
+        // spread the first serves over the whole field so they don't all start in one column
+        arena.store.x[EntitySlot(arena.store, ball)] = LcgRand(arena.seed) / 32767.0f * 1.6f - 0.8f;
+    }
+}
+
+void TickArena(Arena& arena, float vert) {
+    EntityStore& store = arena.store;
+
+    unsigned int player = EntitySlot(store, arena.paddles[0]);
+    store.y[player] += StepPaddle(arena.player, store.y[player] - store.halfHeight[player], store.y[player] + store.halfHeight[player], vert);
+    TrackSystem(store, arena.paddles[1]);
+
+    IntegrateSystem(store);
+    WallSystem(store);
+
+    if (arena.broadphase == ARENA_GRID)
+        arena.grid.Update(store);
+    else
+        arena.sweep.Update(store);
+    const std::vector<CollisionPair>& pairs = arena.broadphase == ARENA_GRID ? arena.grid.Pairs() : arena.sweep.Pairs();
+
+    arena.bounces = 0;
+    for (const CollisionPair& pair : pairs) {
+        bool aCircle = store.shape[pair.a] == COLLIDER_CIRCLE;
+        bool bCircle = store.shape[pair.b] == COLLIDER_CIRCLE;
+        if (aCircle && bCircle)
+            arena.bounces += BounceCircles(store, pair.a, pair.b);
+        else if (aCircle)
+            BounceOffBox(store, pair.a, pair.b, arenaSpeedInc, arenaMaxSpeed);
+        else
+            BounceOffBox(store, pair.b, pair.a, arenaSpeedInc, arenaMaxSpeed);
+    }
+
+    OutOfBoundsSystem(store, arena.out);
+    for (int side = 0; side < 2; side++) {
+        arena.score[side] += (unsigned int)arena.out[side].size();
+        for (Entity ball : arena.out[side])
+            Serve(arena, ball);
+    }
+
+    arena.ticks++;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include "EntityStore.h"
+#include "Broadphase.h"
+#include "Paddle.h"
+
+// chaos mode, the classic paddles against any number of balls that also bounce off each other
+// player 1 is on the left like the classic match, the right paddle is the bot
+
+const float arenaSpeedInc = 0.0001f; // same as the classic match
+const float arenaMaxSpeed = 0.02f; // any faster and a ball can skip through a paddle in one tick
+
+enum ArenaBroadphase {
+    ARENA_GRID,
+    ARENA_SWEEP
+};
+
+struct Arena {
+    EntityStore store;
+    ArenaBroadphase broadphase;
+    UniformGrid grid;
+    SweepAndPrune sweep;
+    Entity paddles[2];
+    PaddleController player;
+    unsigned int score[2];
+    unsigned int seed; // LcgRand state for serves
+    unsigned int ticks;
+    float ballRadius;
+    unsigned int bounces; // ball against ball in the last tick
+    std::vector<Entity> out[2]; // reused every tick
+};
+
+// balls shrink when there are more than fit at the classic size
+float ArenaBallRadius(unsigned int balls);
+
+void InitArena(Arena& arena, unsigned int balls, unsigned int seed, ArenaBroadphase broadphase = ARENA_GRID);
+
+// vert moves player 1 like TickMatch
+void TickArena(Arena& arena, float vert);
@@ -0,0 +1,26 @@
+#include "Batch.h"
+
+void InitBatch(std::vector<MatchState>& matches, size_t count, unsigned int seed) {
+    matches.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        InitMatch(matches[i], BatchSeed(seed, i));
+    }
+}
+
+void TickBatch(std::vector<MatchState>& matches, const float* verts) {
+    for (size_t i = 0; i < matches.size(); i++) {
+        if (!MatchOver(matches[i]))
+            TickMatch(matches[i], verts ? verts[i] : 0.0f);
+    }
+}
+
+unsigned long long PlayBatch(std::vector<MatchState>& matches) {
+    unsigned long long ticks = 0;
+    for (size_t i = 0; i < matches.size(); i++) {
+        while (!MatchOver(matches[i])) {
+            TickMatch(matches[i], 0.0f);
+            ticks++;
+        }
+    }
+    return ticks;
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "Match.h"
+#include "Policies.h"
+
+// many independent matches ticked together, used by the headless tools
+
+// the seed InitBatch gives match index of a batch
+inline unsigned int BatchSeed(unsigned int seed, size_t index) {
+    return seed + (unsigned int)index * 2654435761u;
+}
+
+// gives every match its own seed derived from one so a whole batch can be replayed
+void InitBatch(std::vector<MatchState>& matches, size_t count, unsigned int seed);
+
+// ticks every match that isn't over yet, verts has one player input per match or is null for none
+void TickBatch(std::vector<MatchState>& matches, const float* verts);
+
+// ticks until every match is over, returns how many match ticks ran
+unsigned long long PlayBatch(std::vector<MatchState>& matches);
+
+// the same for matches with their own controllers, each pairing of policies compiles to its own loop
+template <typename LeftPolicy, typename RightPolicy>
+void InitBatch(std::vector<Match<LeftPolicy, RightPolicy>>& matches, size_t count, unsigned int seed) {
+    matches.resize(count);
+    for (size_t i = 0; i < count; i++) {
+        InitMatch(matches[i].state, BatchSeed(seed, i));
+    }
+}
+
+// ticks every match that isn't over yet, returns how many that was
+template <typename LeftPolicy, typename RightPolicy>
+size_t TickBatch(std::vector<Match<LeftPolicy, RightPolicy>>& matches) {
+    size_t ticked = 0;
+    for (size_t i = 0; i < matches.size(); i++) {
+        if (!MatchOver(matches[i].state)) {
+            TickMatch(matches[i]);
+            ticked++;
+        }
+    }
+    return ticked;
+}
+
+template <typename LeftPolicy, typename RightPolicy>
+unsigned long long PlayBatch(std::vector<Match<LeftPolicy, RightPolicy>>& matches) {
+    unsigned long long ticks = 0;
+    for (size_t i = 0; i < matches.size(); i++) {
+        while (!MatchOver(matches[i].state)) {
+            TickMatch(matches[i]);
+            ticks++;
+        }
+    }
+    return ticks;
+}
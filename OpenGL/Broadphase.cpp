@@ -0,0 +1,258 @@
+#include "Broadphase.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Systems.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BROADPHASE_SSE2
+#include <emmintrin.h>
+#endif
+
+void SweepAndPrune::Update(const EntityStore& store) {
+    if (m_Tracked.size() < store.slots.size())
+        m_Tracked.resize(store.slots.size(), 0);
+
+    // refresh bounds and drop entries for entities that are gone
+    size_t kept = 0;
+    for (size_t i = 0; i < m_Entries.size(); i++) {
+        Entry entry = m_Entries[i];
+        if (!EntityAlive(store, entry.entity) || store.shape[EntitySlot(store, entry.entity)] == COLLIDER_NONE) {
+            m_Tracked[entry.entity] = 0;
+            continue;
+        }
+
+        unsigned int slot = EntitySlot(store, entry.entity);
+        entry.slot = slot;
+        entry.minX = store.x[slot] - store.halfWidth[slot];
+        entry.maxX = store.x[slot] + store.halfWidth[slot];
+        entry.minY = store.y[slot] - store.halfHeight[slot];
+        entry.maxY = store.y[slot] + store.halfHeight[slot];
+        entry.box = store.shape[slot] == COLLIDER_BOX;
+        m_Entries[kept++] = entry;
+    }
+    m_Entries.resize(kept);
+
+    // new entities go on the end and the sort moves them into place
+    for (size_t slot = 0; slot < EntityCount(store); slot++) {
+        Entity entity = store.entities[slot];
+        if (m_Tracked[entity] || store.shape[slot] == COLLIDER_NONE)
+            continue;
+        m_Tracked[entity] = 1;
+
+        Entry entry;
+        entry.slot = (unsigned int)slot;
+        entry.entity = entity;
+        entry.minX = store.x[slot] - store.halfWidth[slot];
+        entry.maxX = store.x[slot] + store.halfWidth[slot];
+        entry.minY = store.y[slot] - store.halfHeight[slot];
+        entry.maxY = store.y[slot] + store.halfHeight[slot];
+        entry.box = store.shape[slot] == COLLIDER_BOX;
+        m_Entries.push_back(entry);
+    }
+
+    // insertion sort, the list is nearly sorted from last tick
+    // a fresh list or lots of balls jumping back to the middle can make it quadratic, so past a budget just sort
+    m_Swaps = 0;
+    const size_t budget = m_Entries.size() * 4 + 64;
+    for (size_t i = 1; i < m_Entries.size(); i++) {
+        Entry entry = m_Entries[i];
+        size_t j = i;
+        while (j > 0 && m_Entries[j - 1].minX > entry.minX) {
+            m_Entries[j] = m_Entries[j - 1];
+            j--;
+        }
+        m_Entries[j] = entry;
+        m_Swaps += (unsigned int)(i - j);
+
+        if (m_Swaps > budget) {
+            std::sort(m_Entries.begin(), m_Entries.end(), [](const Entry& a, const Entry& b) { return a.minX < b.minX; });
+            break;
+        }
+    }
+
+    // sweep, everything that starts before an entry ends overlaps it along x
+    m_Pairs.clear();
+    const size_t count = m_Entries.size();
+    for (size_t i = 0; i < count; i++) {
+        const Entry& a = m_Entries[i];
+        for (size_t j = i + 1; j < count && m_Entries[j].minX <= a.maxX; j++) {
+            const Entry& b = m_Entries[j];
+            if (b.minY > a.maxY || b.maxY < a.minY || (a.box && b.box))
+                continue;
+            m_Pairs.push_back({ a.slot, b.slot });
+        }
+    }
+}
+
+// a grid this big never pays for itself, past it cells get bigger instead
+static const unsigned int maxGridCells = 1 << 20;
+
+unsigned int UniformGrid::CellColumn(float x) const {
+    // anything off the edge is clamped into the border cells, which only ever merges neighbours
+    // truncating instead of flooring only differs below zero, which gets clamped anyway
+    int column = (int)((x + 1.0f) * m_InvCellWidth);
+    return (unsigned int)std::min(std::max(column, 0), (int)m_Columns - 1);
+}
+
+unsigned int UniformGrid::CellRow(float y) const {
+    int row = (int)((y + 1.0f) * m_InvCellHeight);
+    return (unsigned int)std::min(std::max(row, 0), (int)m_Rows - 1);
+}
+
+// circle i against the sorted circles from begin to end, four at a time
+static void CollectCircleHits(const float* x, const float* y, const float* radius, const unsigned int* slots,
+    unsigned int i, unsigned int begin, unsigned int end, std::vector<CollisionPair>& pairs) {
+    unsigned int j = begin;
+#ifdef BROADPHASE_SSE2
+    const __m128 cx = _mm_set1_ps(x[i]);
+    const __m128 cy = _mm_set1_ps(y[i]);
+    const __m128 cr = _mm_set1_ps(radius[i]);
+    const __m128 aspect = _mm_set1_ps(worldAspect);
+    // the same operations as CircleCircleOverlap in the same order, a divide rather than a multiply by the inverse
+    // so a pair right at the touching distance is found whichever lane it lands in
+    for (; j + 4 <= end; j += 4) {
+        __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + j), cx);
+        __m128 dy = _mm_div_ps(_mm_sub_ps(_mm_loadu_ps(y + j), cy), aspect);
+        __m128 reach = _mm_add_ps(_mm_loadu_ps(radius + j), cr);
+        __m128 distance = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        int hits = _mm_movemask_ps(_mm_cmplt_ps(distance, _mm_mul_ps(reach, reach)));
+        if (hits) {
+            for (unsigned int lane = 0; lane < 4; lane++) {
+                if (hits & (1 << lane))
+                    pairs.push_back({ slots[i], slots[j + lane] });
+            }
+        }
+    }
+#endif
+    for (; j < end; j++) {
+        if (CircleCircleOverlap(x[i], y[i], radius[i], x[j], y[j], radius[j]))
+            pairs.push_back({ slots[i], slots[j] });
+    }
+}
+
+void UniformGrid::Update(const EntityStore& store) {
+    m_Circles.clear();
+    m_Boxes.clear();
+    m_Pairs.clear();
+
+    float maxHalfWidth = 0.0f;
+    float maxHalfHeight = 0.0f;
+    for (unsigned int slot = 0; slot < EntityCount(store); slot++) {
+        if (store.shape[slot] == COLLIDER_CIRCLE) {
+            m_Circles.push_back(slot);
+            maxHalfWidth = std::max(maxHalfWidth, store.halfWidth[slot]);
+            maxHalfHeight = std::max(maxHalfHeight, store.halfHeight[slot]);
+        }
+        else if (store.shape[slot] == COLLIDER_BOX) {
+            m_Boxes.push_back(slot);
+        }
+    }
+
+    // size the cells to the biggest circle, with about as many cells as circles at most
+    const unsigned int count = (unsigned int)m_Circles.size();
+    float columns = maxHalfWidth > 0.0f ? std::floor(1.0f / maxHalfWidth) : 1.0f;
+    float rows = maxHalfHeight > 0.0f ? std::floor(1.0f / maxHalfHeight) : 1.0f;
+    const float cellLimit = (float)std::min(std::max(count, 1u) * 2, maxGridCells);
+    if (columns * rows > cellLimit) {
+        float shrink = std::sqrt(cellLimit / (columns * rows));
+        columns = std::floor(columns * shrink);
+        rows = std::floor(rows * shrink);
+    }
+    m_Columns = (unsigned int)std::max(columns, 1.0f);
+    m_Rows = (unsigned int)std::max(rows, 1.0f);
+    m_InvCellWidth = m_Columns / 2.0f;
+    m_InvCellHeight = m_Rows / 2.0f;
+
+    // counting sort by cell, row by row so neighbouring columns end up next to each other
+    const unsigned int cells = m_Columns * m_Rows;
+    m_CellStart.assign(cells + 1, 0);
+    m_CircleCells.resize(count);
+    for (unsigned int c = 0; c < count; c++) {
+        unsigned int slot = m_Circles[c];
+        unsigned int cell = CellRow(store.y[slot]) * m_Columns + CellColumn(store.x[slot]);
+        m_CircleCells[c] = cell;
+        m_CellStart[cell + 1]++;
+    }
+    for (unsigned int cell = 0; cell < cells; cell++)
+        m_CellStart[cell + 1] += m_CellStart[cell];
+
+    m_Cursor.assign(m_CellStart.begin(), m_CellStart.end() - 1);
+    m_X.resize(count);
+    m_Y.resize(count);
+    m_Radius.resize(count);
+    m_Slots.resize(count);
+    for (unsigned int c = 0; c < count; c++) {
+        unsigned int slot = m_Circles[c];
+        unsigned int index = m_Cursor[m_CircleCells[c]]++;
+        m_X[index] = store.x[slot];
+        m_Y[index] = store.y[slot];
+        m_Radius[index] = store.halfWidth[slot];
+        m_Slots[index] = slot;
+    }
+
+    // each circle against the rest of its own cell and the one to the right, which sit next to each other,
+    // then the three cells above, which do too, so every touching pair comes up exactly once
+    for (unsigned int row = 0; row < m_Rows; row++) {
+        for (unsigned int column = 0; column < m_Columns; column++) {
+            unsigned int cell = row * m_Columns + column;
+            unsigned int sameEnd = m_CellStart[cell + (column + 1 < m_Columns ? 2 : 1)];
+            unsigned int aboveBegin = 0, aboveEnd = 0;
+            if (row + 1 < m_Rows) {
+                unsigned int above = cell + m_Columns;
+                aboveBegin = m_CellStart[above - (column > 0 ? 1 : 0)];
+                aboveEnd = m_CellStart[above + (column + 1 < m_Columns ? 2 : 1)];
+            }
+
+            for (unsigned int i = m_CellStart[cell]; i < m_CellStart[cell + 1]; i++) {
+                CollectCircleHits(m_X.data(), m_Y.data(), m_Radius.data(), m_Slots.data(), i, i + 1, sameEnd, m_Pairs);
+                CollectCircleHits(m_X.data(), m_Y.data(), m_Radius.data(), m_Slots.data(), i, aboveBegin, aboveEnd, m_Pairs);
+            }
+        }
+    }
+
+    // circles are binned by their centre, so a box looks through every cell a touching circle's centre could be in
+    // the cells in one row are next to each other, so each row is one batch for the collision kernel
+    for (unsigned int box : m_Boxes) {
+        float halfWidth = store.halfWidth[box];
+        float halfHeight = store.halfHeight[box];
+        unsigned int firstColumn = CellColumn(store.x[box] - halfWidth - maxHalfWidth);
+        unsigned int lastColumn = CellColumn(store.x[box] + halfWidth + maxHalfWidth);
+        unsigned int firstRow = CellRow(store.y[box] - halfHeight - maxHalfHeight);
+        unsigned int lastRow = CellRow(store.y[box] + halfHeight + maxHalfHeight);
+
+        for (unsigned int row = firstRow; row <= lastRow; row++) {
+            unsigned int begin = m_CellStart[row * m_Columns + firstColumn];
+            unsigned int end = m_CellStart[row * m_Columns + lastColumn + 1];
+
+            m_Contacts.clear();
+            CollideCirclesBoxes({ m_X.data() + begin, m_Y.data() + begin, m_Radius.data() + begin, end - begin },
+                { &store.x[box], &store.y[box], &halfWidth, &halfHeight, 1 }, m_Contacts);
+            for (const BoxContact& contact : m_Contacts)
+                m_Pairs.push_back({ m_Slots[begin + contact.circle], box });
+        }
+    }
+}
+
+void BruteForcePairs(const EntityStore& store, std::vector<CollisionPair>& pairs) {
+    pairs.clear();
+    const unsigned int count = (unsigned int)EntityCount(store);
+    for (unsigned int a = 0; a < count; a++) {
+        if (store.shape[a] != COLLIDER_CIRCLE)
+            continue;
+        for (unsigned int b = 0; b < count; b++) {
+            if (b == a || store.shape[b] == COLLIDER_NONE)
+                continue;
+            if (store.shape[b] == COLLIDER_CIRCLE) {
+                if (b > a && CircleCircleOverlap(store.x[a], store.y[a], store.halfWidth[a], store.x[b], store.y[b], store.halfWidth[b]))
+                    pairs.push_back({ a, b });
+            }
+            else {
+                BoxContact contact;
+                if (CircleBoxContact(store.x[a], store.y[a], store.halfWidth[a], store.x[b], store.y[b], store.halfWidth[b], store.halfHeight[b], contact))
+                    pairs.push_back({ a, b });
+            }
+        }
+    }
+}
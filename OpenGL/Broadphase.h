@@ -0,0 +1,82 @@
+#pragma once
+
+#include <vector>
+
+#include "EntityStore.h"
+#include "Collision.h"
+
+// two entities whose bounding boxes overlap, as slots into the store
+struct CollisionPair {
+    unsigned int a;
+    unsigned int b;
+};
+
+// sort and sweep along x
+// the order is kept between updates and fixed up with an insertion sort, which is close to linear
+// since nothing moves far in one tick
+class SweepAndPrune {
+public:
+    SweepAndPrune()
+        : m_Swaps(0) {}
+
+    // picks up new and destroyed entities, re-sorts, and finds every overlapping pair that isn't two boxes
+    void Update(const EntityStore& store);
+
+    const std::vector<CollisionPair>& Pairs() const { return m_Pairs; }
+
+    // how many places entries moved in the last sort, near zero when the order barely changed
+    unsigned int Swaps() const { return m_Swaps; }
+
+private:
+    struct Entry {
+        float minX, maxX, minY, maxY;
+        unsigned int slot;
+        Entity entity;
+        bool box;
+    };
+
+    std::vector<Entry> m_Entries; // sorted by minX after an update
+    std::vector<unsigned char> m_Tracked; // per entity id, whether it has an entry
+    std::vector<CollisionPair> m_Pairs;
+    unsigned int m_Swaps;
+};
+
+// uniform grid rebuilt from scratch every tick with a counting sort
+// cells are at least one ball across, so a ball can only touch balls in its own cell and the eight around it
+// and the work stays linear as long as the balls are spread out
+// boxes aren't put in the grid, each one looks up the cells it covers instead, which is cheap for a couple of paddles
+class UniformGrid {
+public:
+    UniformGrid()
+        : m_Columns(0), m_Rows(0), m_InvCellWidth(0.0f), m_InvCellHeight(0.0f) {}
+
+    // finds every pair of touching circles and every circle touching a box
+    void Update(const EntityStore& store);
+
+    const std::vector<CollisionPair>& Pairs() const { return m_Pairs; }
+
+    unsigned int Columns() const { return m_Columns; }
+    unsigned int Rows() const { return m_Rows; }
+
+private:
+    unsigned int CellColumn(float x) const;
+    unsigned int CellRow(float y) const;
+
+    std::vector<unsigned int> m_Circles; // slots, scratch for the sort
+    std::vector<unsigned int> m_CircleCells;
+    std::vector<unsigned int> m_Boxes;
+
+    // circles sorted by cell, one array per component so the pair test can load four at a time
+    std::vector<float> m_X, m_Y, m_Radius;
+    std::vector<unsigned int> m_Slots;
+    std::vector<unsigned int> m_CellStart; // where each cell's circles begin, one extra on the end
+    std::vector<unsigned int> m_Cursor;
+
+    std::vector<BoxContact> m_Contacts;
+    std::vector<CollisionPair> m_Pairs;
+    unsigned int m_Columns, m_Rows;
+    float m_InvCellWidth, m_InvCellHeight;
+};
+
+// every circle against everything else, only here to check and measure the broadphases against
+void BruteForcePairs(const EntityStore& store, std::vector<CollisionPair>& pairs);
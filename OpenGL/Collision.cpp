@@ -0,0 +1,192 @@
+#include "Collision.h"
+
+#include "Cpu.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+// fma is left off on purpose, fused multiplies round differently and the kernels have to agree bit for bit
+
+typedef void (*BoxKernel)(const CircleArrays& circles, unsigned int box, float bx, float by, float halfWidth, float halfHeight,
+    size_t first, std::vector<BoxContact>& contacts);
+
+static void CollideBoxScalar(const CircleArrays& circles, unsigned int box, float bx, float by, float halfWidth, float halfHeight,
+    size_t first, std::vector<BoxContact>& contacts) {
+    for (size_t i = first; i < circles.count; i++) {
+        BoxContact contact;
+        if (CircleBoxContact(circles.x[i], circles.y[i], circles.radius[i], bx, by, halfWidth, halfHeight, contact)) {
+            contact.circle = (unsigned int)i;
+            contact.box = box;
+            contacts.push_back(contact);
+        }
+    }
+}
+
+#ifdef CPU_X86
+
+// the vector kernels do exactly the operations CircleBoxContact does, in the same order, on 4 or 8 circles at once
+// both sides of every branch get worked out and the lanes pick between them
+
+static void PushLanes(int hits, size_t first, unsigned int box, const float* normalX, const float* normalY, const float* depth,
+    std::vector<BoxContact>& contacts) {
+    for (int lane = 0; hits; lane++, hits >>= 1) {
+        if (hits & 1)
+            contacts.push_back({ (unsigned int)(first + lane), box, normalX[lane], normalY[lane], depth[lane] });
+    }
+}
+
+CPU_TARGET("sse4.1")
+static void CollideBoxSse41(const CircleArrays& circles, unsigned int box, float bx, float by, float halfWidth, float halfHeight,
+    size_t first, std::vector<BoxContact>& contacts) {
+    const __m128 left = _mm_set1_ps(bx - halfWidth);
+    const __m128 right = _mm_set1_ps(bx + halfWidth);
+    const __m128 bottom = _mm_set1_ps(by - halfHeight);
+    const __m128 top = _mm_set1_ps(by + halfHeight);
+    const __m128 centreX = _mm_set1_ps(bx);
+    const __m128 centreY = _mm_set1_ps(by);
+    const __m128 halfW = _mm_set1_ps(halfWidth);
+    const __m128 halfH = _mm_set1_ps(halfHeight);
+    const __m128 aspect = _mm_set1_ps(worldAspect);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 minusOne = _mm_set1_ps(-1.0f);
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+
+    alignas(16) float normalX[4], normalY[4], depth[4];
+    size_t i = first;
+    for (; i + 4 <= circles.count; i += 4) {
+        __m128 cx = _mm_loadu_ps(circles.x + i);
+        __m128 cy = _mm_loadu_ps(circles.y + i);
+        __m128 radius = _mm_loadu_ps(circles.radius + i);
+
+        // the operand order matches the scalar ternaries, so even signed zeros come out the same
+        __m128 dx = _mm_sub_ps(cx, _mm_min_ps(right, _mm_max_ps(left, cx)));
+        __m128 dy = _mm_div_ps(_mm_sub_ps(cy, _mm_min_ps(top, _mm_max_ps(bottom, cy))), aspect);
+        __m128 distanceSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        int hits = _mm_movemask_ps(_mm_cmple_ps(distanceSq, _mm_mul_ps(radius, radius)));
+        if (!hits)
+            continue;
+
+        __m128 outside = _mm_cmpgt_ps(distanceSq, zero);
+        __m128 distance = _mm_sqrt_ps(distanceSq);
+
+        __m128 offsetX = _mm_sub_ps(cx, centreX);
+        __m128 offsetY = _mm_sub_ps(cy, centreY);
+        __m128 insideX = _mm_sub_ps(halfW, _mm_andnot_ps(signBit, offsetX));
+        __m128 insideY = _mm_div_ps(_mm_sub_ps(halfH, _mm_andnot_ps(signBit, offsetY)), aspect);
+        __m128 sideX = _mm_cmple_ps(insideX, insideY);
+        __m128 signX = _mm_blendv_ps(one, minusOne, _mm_cmplt_ps(offsetX, zero));
+        __m128 signY = _mm_blendv_ps(one, minusOne, _mm_cmplt_ps(offsetY, zero));
+
+        __m128 insideNormalX = _mm_blendv_ps(zero, signX, sideX);
+        __m128 insideNormalY = _mm_blendv_ps(signY, zero, sideX);
+        __m128 insideDepth = _mm_add_ps(radius, _mm_blendv_ps(insideY, insideX, sideX));
+
+        _mm_store_ps(normalX, _mm_blendv_ps(insideNormalX, _mm_div_ps(dx, distance), outside));
+        _mm_store_ps(normalY, _mm_blendv_ps(insideNormalY, _mm_div_ps(dy, distance), outside));
+        _mm_store_ps(depth, _mm_blendv_ps(insideDepth, _mm_sub_ps(radius, distance), outside));
+        PushLanes(hits, i, box, normalX, normalY, depth, contacts);
+    }
+    CollideBoxScalar(circles, box, bx, by, halfWidth, halfHeight, i, contacts);
+}
+
+CPU_TARGET("avx2")
+static void CollideBoxAvx2(const CircleArrays& circles, unsigned int box, float bx, float by, float halfWidth, float halfHeight,
+    size_t first, std::vector<BoxContact>& contacts) {
+    const __m256 left = _mm256_set1_ps(bx - halfWidth);
+    const __m256 right = _mm256_set1_ps(bx + halfWidth);
+    const __m256 bottom = _mm256_set1_ps(by - halfHeight);
+    const __m256 top = _mm256_set1_ps(by + halfHeight);
+    const __m256 centreX = _mm256_set1_ps(bx);
+    const __m256 centreY = _mm256_set1_ps(by);
+    const __m256 halfW = _mm256_set1_ps(halfWidth);
+    const __m256 halfH = _mm256_set1_ps(halfHeight);
+    const __m256 aspect = _mm256_set1_ps(worldAspect);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 minusOne = _mm256_set1_ps(-1.0f);
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+
+    alignas(32) float normalX[8], normalY[8], depth[8];
+    size_t i = first;
+    for (; i + 8 <= circles.count; i += 8) {
+        __m256 cx = _mm256_loadu_ps(circles.x + i);
+        __m256 cy = _mm256_loadu_ps(circles.y + i);
+        __m256 radius = _mm256_loadu_ps(circles.radius + i);
+
+        __m256 dx = _mm256_sub_ps(cx, _mm256_min_ps(right, _mm256_max_ps(left, cx)));
+        __m256 dy = _mm256_div_ps(_mm256_sub_ps(cy, _mm256_min_ps(top, _mm256_max_ps(bottom, cy))), aspect);
+        __m256 distanceSq = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        int hits = _mm256_movemask_ps(_mm256_cmp_ps(distanceSq, _mm256_mul_ps(radius, radius), _CMP_LE_OQ));
+        if (!hits)
+            continue;
+
+        __m256 outside = _mm256_cmp_ps(distanceSq, zero, _CMP_GT_OQ);
+        __m256 distance = _mm256_sqrt_ps(distanceSq);
+
+        __m256 offsetX = _mm256_sub_ps(cx, centreX);
+        __m256 offsetY = _mm256_sub_ps(cy, centreY);
+        __m256 insideX = _mm256_sub_ps(halfW, _mm256_andnot_ps(signBit, offsetX));
+        __m256 insideY = _mm256_div_ps(_mm256_sub_ps(halfH, _mm256_andnot_ps(signBit, offsetY)), aspect);
+        __m256 sideX = _mm256_cmp_ps(insideX, insideY, _CMP_LE_OQ);
+        __m256 signX = _mm256_blendv_ps(one, minusOne, _mm256_cmp_ps(offsetX, zero, _CMP_LT_OQ));
+        __m256 signY = _mm256_blendv_ps(one, minusOne, _mm256_cmp_ps(offsetY, zero, _CMP_LT_OQ));
+
+        __m256 insideNormalX = _mm256_blendv_ps(zero, signX, sideX);
+        __m256 insideNormalY = _mm256_blendv_ps(signY, zero, sideX);
+        __m256 insideDepth = _mm256_add_ps(radius, _mm256_blendv_ps(insideY, insideX, sideX));
+
+        _mm256_store_ps(normalX, _mm256_blendv_ps(insideNormalX, _mm256_div_ps(dx, distance), outside));
+        _mm256_store_ps(normalY, _mm256_blendv_ps(insideNormalY, _mm256_div_ps(dy, distance), outside));
+        _mm256_store_ps(depth, _mm256_blendv_ps(insideDepth, _mm256_sub_ps(radius, distance), outside));
+        PushLanes(hits, i, box, normalX, normalY, depth, contacts);
+    }
+    CollideBoxScalar(circles, box, bx, by, halfWidth, halfHeight, i, contacts);
+}
+
+#endif
+
+static CollisionKernel DetectKernel() {
+    if (Cpu().avx2)
+        return COLLISION_AVX2;
+    if (Cpu().sse41)
+        return COLLISION_SSE41;
+    return COLLISION_SCALAR;
+}
+
+CollisionKernel BestCollisionKernel() {
+    static const CollisionKernel best = DetectKernel();
+    return best;
+}
+
+static CollisionKernel activeKernel = BestCollisionKernel();
+
+void UseCollisionKernel(CollisionKernel kernel) {
+    activeKernel = kernel <= BestCollisionKernel() ? kernel : BestCollisionKernel();
+}
+
+CollisionKernel ActiveCollisionKernel() {
+    return activeKernel;
+}
+
+const char* CollisionKernelName(CollisionKernel kernel) {
+    switch (kernel) {
+    case COLLISION_SSE41: return "sse4.1";
+    case COLLISION_AVX2: return "avx2";
+    default: return "scalar";
+    }
+}
+
+void CollideCirclesBoxes(const CircleArrays& circles, const BoxArrays& boxes, std::vector<BoxContact>& contacts) {
+    BoxKernel kernel = CollideBoxScalar;
+#ifdef CPU_X86
+    if (activeKernel == COLLISION_AVX2)
+        kernel = CollideBoxAvx2;
+    else if (activeKernel == COLLISION_SSE41)
+        kernel = CollideBoxSse41;
+#endif
+
+    for (size_t b = 0; b < boxes.count; b++)
+        kernel(circles, (unsigned int)b, boxes.x[b], boxes.y[b], boxes.halfWidth[b], boxes.halfHeight[b], 0, contacts);
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+
+#include "EntityStore.h"
+
+// exact circle against axis aligned box tests
+// circles are round once y is divided by worldAspect, so distances, normals and depths are all in that space
+// touching counts as a contact, a ball sitting exactly on a paddle's edge still bounces
+
+// normal points from the box towards the circle, depth is how far the circle has to move along it to stop touching
+struct BoxContact {
+    unsigned int circle;
+    unsigned int box;
+    float normalX;
+    float normalY;
+    float depth;
+};
+
+// single pair, fills everything but circle and box
+inline bool CircleBoxContact(float cx, float cy, float radius, float bx, float by, float halfWidth, float halfHeight, BoxContact& contact) {
+    float nearX = cx < bx - halfWidth ? bx - halfWidth : (cx > bx + halfWidth ? bx + halfWidth : cx);
+    float nearY = cy < by - halfHeight ? by - halfHeight : (cy > by + halfHeight ? by + halfHeight : cy);
+    float dx = cx - nearX;
+    float dy = (cy - nearY) / worldAspect;
+    float distanceSq = dx * dx + dy * dy;
+    if (distanceSq > radius * radius)
+        return false;
+
+    if (distanceSq > 0.0f) {
+        float distance = std::sqrt(distanceSq);
+        contact.normalX = dx / distance;
+        contact.normalY = dy / distance;
+        contact.depth = radius - distance;
+        return true;
+    }
+
+    // the centre is inside, push out through the nearest side
+    float offsetX = cx - bx;
+    float offsetY = cy - by;
+    float insideX = halfWidth - std::fabs(offsetX);
+    float insideY = (halfHeight - std::fabs(offsetY)) / worldAspect;
+    if (insideX <= insideY) {
+        contact.normalX = offsetX < 0.0f ? -1.0f : 1.0f;
+        contact.normalY = 0.0f;
+        contact.depth = radius + insideX;
+    }
+    else {
+        contact.normalX = 0.0f;
+        contact.normalY = offsetY < 0.0f ? -1.0f : 1.0f;
+        contact.depth = radius + insideY;
+    }
+    return true;
+}
+
+// component arrays, like the ones in an EntityStore
+struct CircleArrays {
+    const float* x;
+    const float* y;
+    const float* radius;
+    size_t count;
+};
+
+struct BoxArrays {
+    const float* x;
+    const float* y;
+    const float* halfWidth;
+    const float* halfHeight;
+    size_t count;
+};
+
+// which implementation the batch test runs, every one gives bit identical contacts in the same order
+// so a replay plays out the same whatever cpu it runs on
+enum CollisionKernel {
+    COLLISION_SCALAR,
+    COLLISION_SSE41,
+    COLLISION_AVX2
+};
+
+// the best kernel this cpu and os support, asks cpuid once
+CollisionKernel BestCollisionKernel();
+
+// the batch test starts on the best kernel, this is for comparing them, unsupported ones fall back to the best
+void UseCollisionKernel(CollisionKernel kernel);
+CollisionKernel ActiveCollisionKernel();
+const char* CollisionKernelName(CollisionKernel kernel);
+
+// every circle against every box, appends the contacts box by box with circles in order within each box
+// circle and box in the contacts are indices into the arrays
+void CollideCirclesBoxes(const CircleArrays& circles, const BoxArrays& boxes, std::vector<BoxContact>& contacts);
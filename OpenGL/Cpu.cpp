@@ -0,0 +1,60 @@
+#include "Cpu.h"
+
+#ifdef CPU_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+static void Cpuid(unsigned int leaf, unsigned int subleaf, unsigned int regs[4]) {
+#ifdef _MSC_VER
+    int info[4];
+    __cpuidex(info, (int)leaf, (int)subleaf);
+    for (int r = 0; r < 4; r++)
+        regs[r] = (unsigned int)info[r];
+#else
+    regs[0] = regs[1] = regs[2] = regs[3] = 0;
+    __get_cpuid_count(leaf, subleaf, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+}
+
+// which register sets the os saves on a context switch
+static unsigned long long Xgetbv() {
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int low, high;
+    __asm__ volatile("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+    return ((unsigned long long)high << 32) | low;
+#endif
+}
+#endif
+
+static CpuFeatures DetectCpu() {
+    CpuFeatures features = { false, false, false };
+#ifdef CPU_X86
+    unsigned int regs[4];
+    Cpuid(0, 0, regs);
+    const unsigned int maxLeaf = regs[0];
+
+    Cpuid(1, 0, regs);
+    features.sse41 = (regs[2] >> 19) & 1;
+    const bool fma = (regs[2] >> 12) & 1;
+    const bool osxsave = (regs[2] >> 27) & 1;
+    const bool avx = (regs[2] >> 28) & 1;
+
+    // the cpu having avx isn't enough, the os has to save the upper halves of the ymm registers too
+    if (maxLeaf >= 7 && osxsave && avx && (Xgetbv() & 6) == 6) {
+        features.fma = fma;
+        Cpuid(7, 0, regs);
+        features.avx2 = (regs[1] >> 5) & 1;
+    }
+#endif
+    return features;
+}
+
+const CpuFeatures& Cpu() {
+    static const CpuFeatures features = DetectCpu();
+    return features;
+}
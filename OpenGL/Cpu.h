@@ -0,0 +1,23 @@
+#pragma once
+
+// instruction sets beyond the baseline, for code that picks a kernel at runtime
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define CPU_X86
+#endif
+
+// msvc lets any function use any intrinsic, gcc and clang need to be told per function
+#if defined(__GNUC__) || defined(__clang__)
+#define CPU_TARGET(isa) __attribute__((target(isa)))
+#else
+#define CPU_TARGET(isa)
+#endif
+
+struct CpuFeatures {
+    bool sse41;
+    bool avx2; // only when the os saves the ymm registers too
+    bool fma;
+};
+
+// asks cpuid once
+const CpuFeatures& Cpu();
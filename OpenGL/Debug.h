@@ -0,0 +1,10 @@
+#pragma once
+
+#ifdef _MSC_VER
+#define DEBUG_BREAK() __debugbreak()
+#else
+#define DEBUG_BREAK() __builtin_trap()
+#endif
+
+// stops in the debugger (or the process) when x is false, in release builds too
+#define ASSERT(x) if (!(x)) DEBUG_BREAK();
@@ -0,0 +1,100 @@
+#include "EntityStore.h"
+
+Entity CreateEntity(EntityStore& store, float x, float y) {
+    Entity entity;
+    if (!store.freeIds.empty()) {
+        entity = store.freeIds.back();
+        store.freeIds.pop_back();
+    }
+    else {
+        entity = (Entity)store.slots.size();
+        store.slots.push_back(noEntity);
+    }
+
+    store.slots[entity] = (unsigned int)store.entities.size();
+    store.entities.push_back(entity);
+
+    store.x.push_back(x);
+    store.y.push_back(y);
+    store.vx.push_back(0.0f);
+    store.vy.push_back(0.0f);
+    store.shape.push_back(COLLIDER_NONE);
+    store.halfWidth.push_back(0.0f);
+    store.halfHeight.push_back(0.0f);
+    store.r.push_back(255);
+    store.g.push_back(255);
+    store.b.push_back(255);
+    return entity;
+}
+
+template <typename T>
+static void MoveLast(std::vector<T>& component, unsigned int slot) {
+    component[slot] = component.back();
+    component.pop_back();
+}
+
+void DestroyEntity(EntityStore& store, Entity entity) {
+    if (!EntityAlive(store, entity))
+        return;
+
+    unsigned int slot = store.slots[entity];
+    Entity moved = store.entities.back();
+
+    MoveLast(store.entities, slot);
+    MoveLast(store.x, slot);
+    MoveLast(store.y, slot);
+    MoveLast(store.vx, slot);
+    MoveLast(store.vy, slot);
+    MoveLast(store.shape, slot);
+    MoveLast(store.halfWidth, slot);
+    MoveLast(store.halfHeight, slot);
+    MoveLast(store.r, slot);
+    MoveLast(store.g, slot);
+    MoveLast(store.b, slot);
+
+    store.slots[moved] = slot;
+    store.slots[entity] = noEntity;
+    store.freeIds.push_back(entity);
+}
+
+bool EntityAlive(const EntityStore& store, Entity entity) {
+    return entity < store.slots.size() && store.slots[entity] != noEntity;
+}
+
+void SetBoxCollider(EntityStore& store, Entity entity, float halfWidth, float halfHeight) {
+    unsigned int slot = store.slots[entity];
+    store.shape[slot] = COLLIDER_BOX;
+    store.halfWidth[slot] = halfWidth;
+    store.halfHeight[slot] = halfHeight;
+}
+
+void SetCircleCollider(EntityStore& store, Entity entity, float radius) {
+    unsigned int slot = store.slots[entity];
+    store.shape[slot] = COLLIDER_CIRCLE;
+    store.halfWidth[slot] = radius;
+    store.halfHeight[slot] = radius * worldAspect;
+}
+
+void SetColor(EntityStore& store, Entity entity, unsigned char r, unsigned char g, unsigned char b) {
+    unsigned int slot = store.slots[entity];
+    store.r[slot] = r;
+    store.g[slot] = g;
+    store.b[slot] = b;
+}
+
+void ClearEntities(EntityStore& store) {
+    // clear keeps the capacity so a store can be refilled every match without allocating
+    store.x.clear();
+    store.y.clear();
+    store.vx.clear();
+    store.vy.clear();
+    store.shape.clear();
+    store.halfWidth.clear();
+    store.halfHeight.clear();
+    store.r.clear();
+    store.g.clear();
+    store.b.clear();
+    store.entities.clear();
+    store.slots.clear();
+    store.freeIds.clear();
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// entities for game modes that have more than one ball and two paddles
+// every component is its own array indexed by slot, so a system only pulls in the arrays it reads
+// and the loops over them are plain float arrays the compiler can vectorize
+
+typedef unsigned int Entity;
+const Entity noEntity = 0xffffffff;
+
+// balls are drawn round on a 16:9 window, so a circle reaches this much further in y than in x
+const float worldAspect = 16.0f / 9;
+
+enum ColliderShape {
+    COLLIDER_NONE,
+    COLLIDER_BOX,
+    COLLIDER_CIRCLE
+};
+
+struct EntityStore {
+    // transform, the center in clip space
+    std::vector<float> x;
+    std::vector<float> y;
+
+    // velocity, added to the transform every tick, zero for things that don't move on their own
+    std::vector<float> vx;
+    std::vector<float> vy;
+
+    // collider, for circles halfWidth is the radius and halfHeight is the radius times worldAspect
+    std::vector<unsigned char> shape;
+    std::vector<float> halfWidth;
+    std::vector<float> halfHeight;
+
+    // render
+    std::vector<unsigned char> r;
+    std::vector<unsigned char> g;
+    std::vector<unsigned char> b;
+
+    // slot to entity and entity to slot, destroying moves the last slot into the hole
+    std::vector<Entity> entities;
+    std::vector<unsigned int> slots; // noEntity for ids that aren't alive
+    std::vector<Entity> freeIds;
+};
+
+// a new entity at x, y with no velocity, no collider and drawn white
+Entity CreateEntity(EntityStore& store, float x, float y);
+
+// slots aren't stable across this, entities are
+void DestroyEntity(EntityStore& store, Entity entity);
+
+bool EntityAlive(const EntityStore& store, Entity entity);
+
+inline size_t EntityCount(const EntityStore& store) {
+    return store.entities.size();
+}
+
+inline unsigned int EntitySlot(const EntityStore& store, Entity entity) {
+    return store.slots[entity];
+}
+
+void SetBoxCollider(EntityStore& store, Entity entity, float halfWidth, float halfHeight);
+void SetCircleCollider(EntityStore& store, Entity entity, float radius);
+void SetColor(EntityStore& store, Entity entity, unsigned char r, unsigned char g, unsigned char b);
+
+void ClearEntities(EntityStore& store);
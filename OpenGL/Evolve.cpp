@@ -0,0 +1,196 @@
+#include "Evolve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "Input.h"
+#include "JobSystem.h"
+#include "Paddle.h"
+
+const unsigned int evolutionMagic = 0x4C4F5645; // "EVOL"
+const unsigned int evolutionVersion = 1;
+const size_t evolveBatch = 64; // matches of one individual handed to a thread at once
+const unsigned int selectionSize = 3; // how many individuals each parent is picked from
+const unsigned int maxPopulation = 1 << 20; // anything bigger in a file means it's broken
+
+const BotParamRange botParamRanges[botParamCount] = {
+    { "step", &BotParams::step, 0.0f, paddleStep }, // no faster than a held key
+    { "engageX", &BotParams::engageX, -1.0f, 1.0f },
+    { "deadZone", &BotParams::deadZone, 0.0f, 0.1f },
+    { "lead", &BotParams::lead, 0.0f, 1.0f },
+    { "recenter", &BotParams::recenter, 0.0f, paddleStep }
+};
+
+// uniform in [0, 1)
+static float RandUnit(unsigned int& rand) {
+    return LcgRand(rand) / 32768.0f;
+}
+
+// standard normal, box muller
+static float RandNormal(unsigned int& rand) {
+    float u = (LcgRand(rand) + 1) / 32769.0f; // never 0 so the log is finite
+    float v = RandUnit(rand);
+    return std::sqrt(-2.0f * std::log(u)) * std::cos(2.0f * (float)pi * v);
+}
+
+void InitEvolution(Evolution& evolution, const EvolveOptions& options) {
+    evolution.generation = 0;
+    evolution.rand = options.seed;
+    evolution.population.assign(options.population, Individual());
+
+    // the first one stays the classic bot so the search never starts out worse than it
+    for (size_t i = 1; i < evolution.population.size(); i++) {
+        for (const BotParamRange& range : botParamRanges)
+            evolution.population[i].params.*range.member = range.low + RandUnit(evolution.rand) * (range.high - range.low);
+    }
+}
+
+// a run of matches of one individual on the same side
+struct EvolveRun {
+    unsigned int individual;
+    bool swapped; // the individual is on the right
+    size_t first; // seed index of the first match
+    size_t count;
+};
+
+size_t EvaluatePopulation(Evolution& evolution, const Entrant& opponent, const EvolveOptions& options, JobSystem& jobs) {
+    std::vector<Individual>& population = evolution.population;
+    const size_t leftHalf = (options.matches + 1) / 2;
+    const size_t rightHalf = options.matches / 2;
+    const size_t firstSeed = evolution.generation * leftHalf;
+
+    std::vector<Entrant> entrants(population.size());
+    std::vector<EvolveRun> runs;
+    for (unsigned int i = 0; i < population.size(); i++) {
+        entrants[i].kind = POLICY_TUNED;
+        entrants[i].params = &population[i].params;
+        for (size_t m = 0; m < leftHalf; m += evolveBatch)
+            runs.push_back({ i, false, firstSeed + m, std::min(evolveBatch, leftHalf - m) });
+        for (size_t m = 0; m < rightHalf; m += evolveBatch)
+            runs.push_back({ i, true, firstSeed + m, std::min(evolveBatch, rightHalf - m) });
+    }
+
+    // every thread counts points into its own tallies, counted as if the individual was always on the left
+    std::vector<std::vector<PairingResult>> tallies(jobs.ThreadCount(), std::vector<PairingResult>(population.size()));
+    jobs.ParallelFor(runs.size(), 1, [&](size_t begin, size_t end) {
+        std::vector<PairingResult>& tally = tallies[JobSystem::ThreadIndex()];
+        for (size_t r = begin; r < end; r++) {
+            const EvolveRun& run = runs[r];
+            const Entrant& individual = entrants[run.individual];
+            PairingResult result;
+            if (run.swapped)
+                PlayPairing(opponent, individual, options.seed, run.first, run.count, result, options.maxTicks);
+            else
+                PlayPairing(individual, opponent, options.seed, run.first, run.count, result, options.maxTicks);
+            AddResult(tally[run.individual], result, run.swapped);
+        }
+    });
+
+    for (size_t i = 0; i < population.size(); i++) {
+        PairingResult total;
+        for (const std::vector<PairingResult>& tally : tallies)
+            AddResult(total, tally[i]);
+        population[i].fitness = options.matches > 0 ? ((double)total.leftPoints - total.rightPoints) / options.matches : 0.0;
+    }
+
+    // stable so equally fit individuals keep their order and a run replays exactly
+    std::stable_sort(population.begin(), population.end(), [](const Individual& a, const Individual& b) {
+        return a.fitness > b.fitness;
+    });
+    return population.size() * options.matches;
+}
+
+// the population is sorted, so the fittest of a few random picks is the one with the lowest index
+static const Individual& SelectParent(const std::vector<Individual>& population, unsigned int& rand) {
+    size_t best = population.size();
+    for (unsigned int i = 0; i < selectionSize; i++)
+        best = std::min(best, (size_t)LcgRand(rand) % population.size());
+    return population[best];
+}
+
+void NextGeneration(Evolution& evolution, const EvolveOptions& options) {
+    const std::vector<Individual>& parents = evolution.population;
+    std::vector<Individual> children;
+    children.reserve(parents.size());
+
+    for (size_t i = 0; i < parents.size() && i < options.elites; i++)
+        children.push_back(parents[i]);
+
+    while (children.size() < parents.size()) {
+        const Individual& mother = SelectParent(parents, evolution.rand);
+        const Individual& father = SelectParent(parents, evolution.rand);
+
+        // each parameter from either parent, then a gaussian nudge to about a third of them
+        Individual child;
+        for (const BotParamRange& range : botParamRanges) {
+            float value = (LcgRand(evolution.rand) & 1 ? mother : father).params.*range.member;
+            if (LcgRand(evolution.rand) % 3 == 0)
+                value += RandNormal(evolution.rand) * options.mutation * (range.high - range.low);
+            child.params.*range.member = ClampFloat(value, range.low, range.high);
+        }
+        children.push_back(child);
+    }
+
+    evolution.population.swap(children);
+    evolution.generation++;
+}
+
+bool SaveEvolution(const char* path, const Evolution& evolution) {
+    const std::string temporary = std::string(path) + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary);
+        if (!out.is_open()) {
+            std::cout << "[Evolve] couldn't write " << temporary << std::endl;
+            return false;
+        }
+
+        unsigned int header[] = { evolutionMagic, evolutionVersion, evolution.generation, evolution.rand, (unsigned int)evolution.population.size() };
+        out.write((const char*)header, sizeof(header));
+        for (const Individual& individual : evolution.population) {
+            for (const BotParamRange& range : botParamRanges)
+                out.write((const char*)&(individual.params.*range.member), sizeof(float));
+            out.write((const char*)&individual.fitness, sizeof(double));
+        }
+        if (!out) {
+            std::cout << "[Evolve] couldn't write " << temporary << std::endl;
+            return false;
+        }
+    }
+
+    // std::rename won't replace an existing file on windows, the filesystem one does it in one step so the old checkpoint is never missing
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    if (error) {
+        std::cout << "[Evolve] couldn't move " << temporary << " to " << path << " (" << error.message() << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool LoadEvolution(const char* path, Evolution& evolution) {
+    std::ifstream in(path, std::ios::binary);
+    unsigned int header[5];
+    if (!in.is_open() || !in.read((char*)header, sizeof(header)) || header[0] != evolutionMagic || header[1] != evolutionVersion
+        || header[4] > maxPopulation) {
+        std::cout << "[Evolve] " << path << " isn't a checkpoint" << std::endl;
+        return false;
+    }
+
+    evolution.generation = header[2];
+    evolution.rand = header[3];
+    evolution.population.assign(header[4], Individual());
+    for (Individual& individual : evolution.population) {
+        for (const BotParamRange& range : botParamRanges)
+            in.read((char*)&(individual.params.*range.member), sizeof(float));
+        in.read((char*)&individual.fitness, sizeof(double));
+    }
+    if (!in) {
+        std::cout << "[Evolve] " << path << " is cut short" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "Policies.h"
+#include "Tournament.h"
+
+class JobSystem;
+
+// a genetic algorithm over BotParams, every generation played out as one batch of matches over a JobSystem
+
+const unsigned int botParamCount = 5;
+
+// what mutation and crossover work on, a BotParams member and the range it's kept in
+struct BotParamRange {
+    const char* name;
+    float BotParams::* member;
+    float low;
+    float high;
+};
+
+extern const BotParamRange botParamRanges[botParamCount];
+
+struct Individual {
+    BotParams params;
+    double fitness = 0.0; // points won minus points lost per match in the last evaluation
+};
+
+struct EvolveOptions {
+    unsigned int population = 64;
+    unsigned int elites = 4; // the best few are carried over unchanged
+    unsigned int matches = 64; // per individual per generation, half on each side
+    unsigned int maxTicks = 20000; // long enough for rallies to outpace the classic bot, matches still going are scored on the points so far
+    float mutation = 0.1f; // how far a mutation moves a parameter, as a fraction of its range
+    unsigned int seed = 1;
+};
+
+struct Evolution {
+    unsigned int generation = 0;
+    unsigned int rand = 0; // LcgRand state for selection and mutation
+    std::vector<Individual> population; // best first once evaluated
+};
+
+// the classic bot and random mutations of it
+void InitEvolution(Evolution& evolution, const EvolveOptions& options);
+
+// plays every individual against opponent and sorts the population by fitness, returns how many matches were played
+// everyone plays the same seeds in a generation so they're compared on the same serves, the seeds move on every generation
+// the fitness is the same whatever the number of threads
+size_t EvaluatePopulation(Evolution& evolution, const Entrant& opponent, const EvolveOptions& options, JobSystem& jobs);
+
+// replaces the population with the elites and children of the fitter individuals, and moves on a generation
+void NextGeneration(Evolution& evolution, const EvolveOptions& options);
+
+// written to a temporary file first and then moved over path, so a run killed while saving still leaves the last checkpoint
+bool SaveEvolution(const char* path, const Evolution& evolution);
+bool LoadEvolution(const char* path, Evolution& evolution);
@@ -0,0 +1,117 @@
+#include "FramePacer.h"
+
+#define GLFW_INCLUDE_NONE // only the glfw functions are needed here
+#include <GLFW/glfw3.h>
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+#include "Debug.h"
+#include "Timing.h"
+
+const size_t maxSamples = 1 << 20; // per mode, stops recording after this many frames
+
+static const char* pacingNames[PACING_MODE_COUNT] = { "vsync", "cap", "uncapped", "adaptive" };
+
+const char* PacingModeName(PacingMode mode) {
+    return pacingNames[mode];
+}
+
+bool ParsePacingMode(const char* name, PacingMode& mode) {
+    for (int i = 0; i < PACING_MODE_COUNT; i++) {
+        if (strcmp(name, pacingNames[i]) == 0) {
+            mode = (PacingMode)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+FramePacer::FramePacer(PacingMode mode, double refreshRate, double capRate)
+    : m_Mode(mode), m_RefreshPeriod(1.0 / refreshRate), m_CapPeriod(1.0 / capRate),
+      m_TearSupported(glfwExtensionSupported("WGL_EXT_swap_control_tear") || glfwExtensionSupported("GLX_EXT_swap_control_tear")),
+      m_LastFrame(Now()), m_Deadline(m_LastFrame), m_SwapInterval(-2), m_Missed(0), m_OnTime(0) {
+    ASSERT(capRate > 0.0); // an infinite cap period would sleep forever in Wait
+    SetMode(mode);
+}
+
+void FramePacer::SetSwapInterval(int interval) {
+    if (interval == m_SwapInterval)
+        return;
+    glfwSwapInterval(interval);
+    m_SwapInterval = interval;
+}
+
+void FramePacer::SetMode(PacingMode mode) {
+    m_Mode = mode;
+    m_Missed = 0;
+    m_OnTime = 0;
+    m_Deadline = Now();
+    m_LastFrame = m_Deadline;
+
+    if (mode == PACING_VSYNC || mode == PACING_ADAPTIVE)
+        SetSwapInterval(1);
+    else
+        SetSwapInterval(0);
+}
+
+void FramePacer::Wait() {
+    if (m_Mode != PACING_CAP)
+        return;
+
+    m_Deadline += m_CapPeriod;
+    double now = Now();
+    if (m_Deadline < now - m_CapPeriod) // way behind, don't rush to catch up
+        m_Deadline = now;
+    SleepUntil(m_Deadline);
+}
+
+void FramePacer::FrameDone() {
+    double now = Now();
+    double frameTime = now - m_LastFrame;
+    m_LastFrame = now;
+
+    std::vector<float>& samples = m_FrameTimes[m_Mode];
+    if (samples.size() < maxSamples)
+        samples.push_back((float)frameTime);
+
+    if (m_Mode != PACING_ADAPTIVE)
+        return;
+
+    // a frame that took over one and a half refreshes missed its vblank
+    if (frameTime > m_RefreshPeriod * 1.5) {
+        m_Missed++;
+        m_OnTime = 0;
+    }
+    else {
+        m_OnTime++;
+        m_Missed = 0;
+    }
+
+    // stop waiting for vsync once a few frames in a row miss it, go back once a second is on time
+    if (m_SwapInterval == 1 && m_Missed >= 3)
+        SetSwapInterval(m_TearSupported ? -1 : 0);
+    else if (m_SwapInterval != 1 && m_OnTime >= (unsigned int)(1.0 / m_RefreshPeriod))
+        SetSwapInterval(1);
+}
+
+static float Percentile(const std::vector<float>& sorted, double p) {
+    size_t index = (size_t)(p * (sorted.size() - 1) + 0.5);
+    return sorted[index];
+}
+
+void FramePacer::Report() const {
+    for (int i = 0; i < PACING_MODE_COUNT; i++) {
+        if (m_FrameTimes[i].empty())
+            continue;
+
+        std::vector<float> sorted = m_FrameTimes[i];
+        std::sort(sorted.begin(), sorted.end());
+
+        std::cout << "[Pacing] " << pacingNames[i] << ": " << sorted.size() << " frames"
+            << ", p50 " << Percentile(sorted, 0.50) * 1000 << "ms"
+            << ", p99 " << Percentile(sorted, 0.99) * 1000 << "ms"
+            << ", p99.9 " << Percentile(sorted, 0.999) * 1000 << "ms" << std::endl;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+enum PacingMode {
+    PACING_VSYNC, // swap interval 1
+    PACING_CAP, // no vsync, sleep then spin to a fixed frame rate
+    PACING_UNCAPPED, // no vsync and no waiting, for benchmarking
+    PACING_ADAPTIVE, // vsync until frames start missing, then drop the swap interval
+    PACING_MODE_COUNT
+};
+
+const char* PacingModeName(PacingMode mode);
+
+// returns false if the name isn't one of the modes
+bool ParsePacingMode(const char* name, PacingMode& mode);
+
+// decides how the render loop waits for the next frame and keeps per mode frame times
+// has to be used from the thread that owns the gl context since it changes the swap interval
+class FramePacer {
+public:
+    FramePacer(PacingMode mode, double refreshRate, double capRate);
+
+    void SetMode(PacingMode mode);
+    PacingMode Mode() const { return m_Mode; }
+
+    // call right before swapping, only waits in cap mode
+    void Wait();
+
+    // call right after swapping
+    void FrameDone();
+
+    // p50/p99/p99.9 frame times for every mode that ran
+    void Report() const;
+
+private:
+    void SetSwapInterval(int interval);
+
+    PacingMode m_Mode;
+    double m_RefreshPeriod;
+    double m_CapPeriod;
+    bool m_TearSupported; // swap interval -1 tears late frames instead of waiting for the next vblank
+
+    double m_LastFrame; // when the last frame was done
+    double m_Deadline; // when the next capped frame is due
+    int m_SwapInterval;
+    unsigned int m_Missed; // frames in a row that were late
+    unsigned int m_OnTime; // frames in a row that were on time
+
+    std::vector<float> m_FrameTimes[PACING_MODE_COUNT];
+};
@@ -0,0 +1,237 @@
+#include "Headless.h"
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <cstring>
+
+#include "Renderer.h"
+#include "HeadlessContext.h"
+#include "Offscreen.h"
+#include "Scene.h"
+#include "Match.h"
+#include "Timing.h"
+#include "Replay.h"
+#include "VideoWriter.h"
+#include "ShapeBatch.h"
+#include "SdfBatch.h"
+#include "Arena.h"
+
+// writes rgba rows that go bottom to top as a top to bottom rgb ppm
+static void WritePPM(const char* path, const unsigned char* pixels, int width, int height) {
+    std::ofstream out(path, std::ios::binary);
+    out << "P6\n" << width << " " << height << "\n255\n";
+    for (int y = height - 1; y >= 0; y--) {
+        const unsigned char* row = pixels + (size_t)y * width * 4;
+        for (int x = 0; x < width; x++)
+            out.write((const char*)row + x * 4, 3);
+    }
+}
+
+// stress test for the shape batcher, every frame is a fresh set of quads, circles and lines
+static int RunBatchStress(const HeadlessOptions& options) {
+    OffscreenTarget target(options.width, options.height);
+    ShapeBatch batch;
+
+    MatchState random; // only used for MatchRand
+    random.seed = options.seed;
+    auto Random = [&]() { return MatchRand(random) / 16383.5f - 1.0f; };
+
+    // positions are generated once so the benchmark measures the batcher and not the rng
+    std::vector<float> shapes((size_t)options.stressShapes * 4);
+    for (float& value : shapes)
+        value = Random();
+
+    target.Bind();
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    double begin = Now();
+    for (unsigned int frame = 0; frame < options.frames; frame++) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        batch.ResetStats();
+
+        float drift = 0.001f * frame; // keeps the vertex data changing every frame
+        for (unsigned int i = 0; i < options.stressShapes; i++) {
+            const float* s = &shapes[(size_t)i * 4];
+            unsigned char shade = (unsigned char)(i * 37);
+            switch (i % 3) {
+            case 0:
+                batch.DrawQuad(s[0] + drift, s[1], s[0] + drift + 0.01f, s[1] + 0.02f, shade, 140, 255);
+                break;
+            case 1:
+                batch.DrawCircle(s[0], s[1] + drift, 0.01f, 16, 255, shade, 255);
+                break;
+            default:
+                batch.DrawLine(s[0], s[1], s[2] + drift, s[3], 0.002f, 255, 255, shade);
+                break;
+            }
+        }
+        batch.Flush();
+    }
+    glFinish();
+    double seconds = Now() - begin;
+    target.Unbind();
+
+    std::cerr << "[Batch] " << options.stressShapes << " shapes a frame, " << options.frames << " frames in " << seconds << "s ("
+        << (options.frames / seconds) << " fps, " << (options.stressShapes * (double)options.frames / seconds / 1e6) << "M shapes/s, "
+        << batch.DrawCalls() << " draw calls and " << batch.BytesUploaded() / 1024 << "KiB a frame)" << std::endl;
+    return 0;
+}
+
+// circles as triangles against circles as distance fields, small ones cost mostly vertices and big ones mostly fill
+static int RunSdfStress(const HeadlessOptions& options) {
+    OffscreenTarget target(options.width, options.height);
+    ShapeBatch shapes;
+    SdfBatch sdf(options.width, options.height);
+
+    MatchState random; // only used for MatchRand
+    random.seed = options.seed;
+    std::vector<float> centers((size_t)options.stressShapes * 2);
+    for (float& value : centers)
+        value = MatchRand(random) / 16383.5f - 1.0f;
+
+    target.Bind();
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    // draw is called once per circle
+    auto Time = [&](const char* name, float radius, auto draw, auto flush) {
+        double begin = Now();
+        for (unsigned int frame = 0; frame < options.frames; frame++) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            for (unsigned int i = 0; i < options.stressShapes; i++)
+                draw(centers[i * 2], centers[i * 2 + 1], radius);
+            flush();
+        }
+        glFinish();
+        double seconds = Now() - begin;
+        std::cerr << "[Sdf] " << name << " radius " << radius << ": " << (seconds / options.frames * 1000.0) << "ms a frame" << std::endl;
+    };
+
+    const float radii[] = { 0.005f, 0.05f };
+    for (float radius : radii) {
+        Time("8 sides", radius, [&](float x, float y, float r) { shapes.DrawCircle(x, y, r, 8, 255, 255, 255); }, [&]() { shapes.Flush(); });
+        Time("64 sides", radius, [&](float x, float y, float r) { shapes.DrawCircle(x, y, r, 64, 255, 255, 255); }, [&]() { shapes.Flush(); });
+        Time("sdf", radius, [&](float x, float y, float r) { sdf.DrawCircle(x, y, r, 255, 255, 255); }, [&]() { sdf.Flush(); });
+    }
+
+    target.Unbind();
+    return 0;
+}
+
+int RunHeadless(const HeadlessOptions& options) {
+    HeadlessContext context;
+    if (!context.Valid())
+        return -1;
+
+    // glew 2.1 also tries to load glx and complains when the context came from egl, the gl functions are still fine
+    GLenum glewStatus = glewInit();
+    if (glewStatus != GLEW_OK && glewStatus != GLEW_ERROR_NO_GLX_DISPLAY) {
+        std::cerr << "Error" << std::endl;
+        return -1;
+    }
+
+    std::cerr << "[Headless] " << glGetString(GL_RENDERER) << std::endl;
+
+    if (options.stressShapes)
+        return options.sdf ? RunSdfStress(options) : RunBatchStress(options);
+
+    Scene scene;
+    CreateScene(scene);
+    Renderer renderer;
+    CommandBuffer commands;
+    SdfBatch sdf(options.width, options.height);
+
+    Replay replay = { options.seed, std::vector<float>() };
+    if (options.replay && !LoadReplay(options.replay, replay))
+        return -1;
+    unsigned int frames = options.replay ? (unsigned int)replay.inputs.size() : options.frames;
+
+    OffscreenTarget target(options.width, options.height);
+    PixelReader reader(options.width, options.height);
+    std::vector<unsigned char> pixels(reader.FrameBytes());
+
+    std::unique_ptr<VideoWriter> video;
+    if (options.capture) {
+        video.reset(new VideoWriter(options.capture, options.width, options.height, (int)tickRate));
+        if (!video->Valid())
+            return -1;
+    }
+
+    // finished frames get copied straight into the video's buffers when capturing
+    unsigned char* frameOut = video ? video->Acquire() : pixels.data();
+    unsigned int framesRead = 0;
+
+    auto ReadFrame = [&](bool wait) {
+        if (!reader.Read(frameOut, wait))
+            return false;
+        framesRead++;
+        if (video) {
+            if (options.thumbnail)
+                memcpy(pixels.data(), frameOut, pixels.size());
+            video->Submit(frameOut);
+            frameOut = video->Acquire();
+        }
+        return true;
+    };
+
+    MatchState state;
+    InitMatch(state, replay.seed);
+
+    Arena arena;
+    if (options.balls)
+        InitArena(arena, options.balls, replay.seed);
+
+    double begin = Now();
+
+    target.Bind();
+    for (unsigned int frame = 0; frame < frames; frame++) {
+        if (options.balls)
+            TickArena(arena, options.replay ? replay.inputs[frame] : 0.0f);
+        else
+            TickMatch(state, options.replay ? replay.inputs[frame] : 0.0f);
+
+        glClear(GL_COLOR_BUFFER_BIT);
+        UploadScene(scene, state.positions);
+        if (options.balls) {
+            RecordBackground(scene, commands);
+            renderer.Submit(commands);
+            DrawEntities(arena.store, sdf);
+            sdf.Flush();
+        }
+        else if (options.sdf) {
+            RecordBackground(scene, commands);
+            renderer.Submit(commands);
+            DrawShapesSdf(sdf, state.positions, 0.0f);
+        }
+        else {
+            RecordScene(scene, commands);
+            RecordPlayer1(scene, commands, 0.0f);
+            renderer.Submit(commands);
+        }
+
+        // pick up whatever the gpu has finished, only wait if the whole ring is still in flight
+        while (ReadFrame(false));
+        if (!reader.Request()) {
+            ReadFrame(true);
+            reader.Request();
+        }
+    }
+    // a dropped frame still comes off the ring, so keep going until it's empty rather than stopping at the first false
+    while (reader.Pending())
+        ReadFrame(true);
+    target.Unbind();
+
+    video.reset(); // waits for the worker to write everything out
+
+    double seconds = Now() - begin;
+    std::cerr << "[Headless] " << framesRead << " frames at " << options.width << "x" << options.height
+        << " in " << seconds << "s (" << (framesRead / seconds) << " fps, "
+        << (framesRead / tickRate / seconds) << "x real time)" << std::endl;
+
+    if (options.thumbnail && framesRead > 0)
+        WritePPM(options.thumbnail, pixels.data(), options.width, options.height);
+
+    glDeleteProgram(scene.shader);
+    return 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+struct HeadlessOptions {
+    unsigned int frames; // one tick and one frame each
+    int width;
+    int height;
+    unsigned int seed;
+    const char* thumbnail; // last frame gets written here as a ppm, null for none
+    const char* capture; // y4m output, "-" for stdout, null for none
+    const char* replay; // replay to play back instead of a new match, null for none
+    unsigned int stressShapes; // draws this many random shapes a frame through a ShapeBatch instead of a match, 0 for a match
+    bool sdf; // ball and paddles as distance field shapes, with stressShapes it compares sdf circles against triangle ones
+    unsigned int balls; // plays an Arena with this many balls instead of the classic match, 0 for the classic match
+};
+
+// plays a match with nothing on screen, drawing every tick offscreen and reading it back
+// logs go to stderr so a capture can go to stdout
+int RunHeadless(const HeadlessOptions& options);
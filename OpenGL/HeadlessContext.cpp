@@ -0,0 +1,106 @@
+#include "HeadlessContext.h"
+
+#include <iostream>
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#else
+#define GLFW_INCLUDE_NONE // only the glfw functions are needed here
+#include <GLFW/glfw3.h>
+#endif
+
+#ifdef __linux__
+
+HeadlessContext::HeadlessContext()
+    : m_Valid(false), m_Display(nullptr), m_Context(nullptr), m_Window(nullptr) {
+    // the surfaceless platform doesn't need an x server or a gpu
+    EGLDisplay display = EGL_NO_DISPLAY;
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if (getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        std::cerr << "[Headless] couldn't initialize egl" << std::endl;
+        return;
+    }
+    m_Display = display;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "[Headless] egl has no desktop gl" << std::endl;
+        return;
+    }
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount == 0)
+        config = nullptr; // EGL_NO_CONFIG_KHR, fine since we never make a surface
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        std::cerr << "[Headless] couldn't create a gl 3.3 context" << std::endl;
+        return;
+    }
+    m_Context = context;
+
+    // no surface at all, everything gets drawn into framebuffer objects
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        std::cerr << "[Headless] couldn't make the context current" << std::endl;
+        return;
+    }
+
+    m_Valid = true;
+}
+
+HeadlessContext::~HeadlessContext() {
+    if (m_Context) {
+        eglMakeCurrent((EGLDisplay)m_Display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext((EGLDisplay)m_Display, (EGLContext)m_Context);
+    }
+    if (m_Display)
+        eglTerminate((EGLDisplay)m_Display);
+}
+
+#else
+
+HeadlessContext::HeadlessContext()
+    : m_Valid(false), m_Display(nullptr), m_Context(nullptr), m_Window(nullptr) {
+    if (!glfwInit())
+        return;
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    GLFWwindow* window = glfwCreateWindow(1, 1, "Headless", NULL, NULL);
+    if (!window) {
+        std::cerr << "[Headless] couldn't create a hidden window" << std::endl;
+        return;
+    }
+    glfwMakeContextCurrent(window);
+
+    m_Window = window;
+    m_Valid = true;
+}
+
+HeadlessContext::~HeadlessContext() {
+    if (m_Window)
+        glfwDestroyWindow((GLFWwindow*)m_Window);
+    glfwTerminate();
+}
+
+#endif
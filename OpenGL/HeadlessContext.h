@@ -0,0 +1,18 @@
+#pragma once
+
+// a gl context with nothing on screen
+// on linux it's surfaceless egl so it works on nodes without a gpu or display (mesa falls back to llvmpipe)
+// everywhere else it's a hidden glfw window
+class HeadlessContext {
+public:
+    HeadlessContext();
+    ~HeadlessContext();
+
+    bool Valid() const { return m_Valid; }
+
+private:
+    bool m_Valid;
+    void* m_Display; // EGLDisplay
+    void* m_Context; // EGLContext
+    void* m_Window; // GLFWwindow
+};
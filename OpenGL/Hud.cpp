@@ -0,0 +1,116 @@
+#include "Hud.h"
+
+#include <GL/glew.h>
+
+// graph layout in clip space
+const float graphLeft = -0.98f;
+const float graphRight = -0.38f;
+const float graphHeight = 0.2f;
+const float graphMax = 1.0f / 30.0f; // a bar reaches the top at 30fps
+
+// seven segment digits, bit 0 is the top segment then clockwise with the middle one last
+static const unsigned char segments[10] = { 0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F };
+
+const float digitWidth = 0.02f;
+const float digitHeight = 0.06f;
+const float segmentThickness = 0.004f;
+
+Hud::Hud()
+    : m_Next(0) {
+    glGenBuffers(1, &m_Buffer);
+    for (unsigned int i = 0; i < hudHistory; i++) {
+        m_FrameTimes[i] = 0.0f;
+        m_SimTimes[i] = 0.0f;
+    }
+}
+
+void Hud::AddFrame(float frameTime, float simTime) {
+    m_FrameTimes[m_Next] = frameTime;
+    m_SimTimes[m_Next] = simTime;
+    m_Next = (m_Next + 1) % hudHistory;
+}
+
+void Hud::AddQuad(float x1, float y1, float x2, float y2) {
+    float quad[] = {
+        x1, y1, x2, y1, x2, y2,
+        x2, y2, x1, y2, x1, y1
+    };
+    m_Vertices.insert(m_Vertices.end(), quad, quad + 12);
+}
+
+void Hud::AddGraph(const float* samples, float top, float scale) {
+    float bottom = top - graphHeight;
+    float barWidth = (graphRight - graphLeft) / hudHistory;
+
+    // oldest on the left
+    for (unsigned int i = 0; i < hudHistory; i++) {
+        float height = samples[(m_Next + i) % hudHistory] / scale;
+        if (height > 1.0f)
+            height = 1.0f;
+        float x = graphLeft + i * barWidth;
+        AddQuad(x, bottom, x + barWidth * 0.6f, bottom + height * graphHeight);
+    }
+
+    // 60fps line
+    float target = (1.0f / 60.0f) / scale * graphHeight;
+    AddQuad(graphLeft, bottom + target, graphRight, bottom + target + 0.003f);
+}
+
+void Hud::AddNumber(unsigned int value, float x, float y) {
+    // count digits so the number can be drawn left to right
+    unsigned int digits = 1;
+    for (unsigned int v = value; v >= 10; v /= 10)
+        digits++;
+
+    float right = x + digits * digitWidth * 1.5f;
+    for (unsigned int i = 0; i < digits; i++) {
+        unsigned char s = segments[value % 10];
+        value /= 10;
+
+        float l = right - (i + 1) * digitWidth * 1.5f;
+        float r = l + digitWidth;
+        float t = y;
+        float m = y - digitHeight / 2;
+        float b = y - digitHeight;
+        float h = segmentThickness / 2;
+
+        if (s & 0x01) AddQuad(l, t - h, r, t + h);
+        if (s & 0x02) AddQuad(r - h, m, r + h, t);
+        if (s & 0x04) AddQuad(r - h, b, r + h, m);
+        if (s & 0x08) AddQuad(l, b - h, r, b + h);
+        if (s & 0x10) AddQuad(l - h, b, l + h, m);
+        if (s & 0x20) AddQuad(l - h, m, l + h, t);
+        if (s & 0x40) AddQuad(l, m - h, r, m + h);
+    }
+}
+
+void Hud::Draw(int colorLocation, unsigned int drawCalls, unsigned int bytesUploaded) {
+    m_Vertices.clear();
+
+    const float frameTop = 0.95f;
+    const float simTop = frameTop - graphHeight - 0.05f;
+    const float textLeft = graphRight + 0.03f;
+
+    unsigned int newest = (m_Next + hudHistory - 1) % hudHistory;
+
+    // frame time and sim time in microseconds next to their graphs
+    AddGraph(m_FrameTimes, frameTop, graphMax);
+    AddNumber((unsigned int)(m_FrameTimes[newest] * 1e6f), textLeft, frameTop);
+
+    // the sim graph is zoomed in 10x since a tick is much shorter than a frame
+    AddGraph(m_SimTimes, simTop, graphMax / 10);
+    AddNumber((unsigned int)(m_SimTimes[newest] * 1e6f), textLeft, simTop);
+
+    // draw calls and bytes uploaded under the graphs
+    const float statsTop = simTop - graphHeight - 0.05f;
+    AddNumber(drawCalls, graphLeft, statsTop);
+    AddNumber(bytesUploaded, graphLeft + 0.15f, statsTop);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+    glBufferData(GL_ARRAY_BUFFER, m_Vertices.size() * sizeof(float), m_Vertices.data(), GL_STREAM_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    glUniform4f(colorLocation, 1.0f, 1.0f, 1.0f, 1.0f);
+    glDrawArrays(GL_TRIANGLES, 0, (GLsizei)(m_Vertices.size() / 2));
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <vector>
+
+const unsigned int hudHistory = 120; // frames shown in the graphs
+
+// performance overlay, everything is one batch of quads drawn in one color with one draw call
+class Hud {
+public:
+    Hud(); // needs the gl context, the buffer goes away with it
+
+    void AddFrame(float frameTime, float simTime);
+
+    // draws with whatever shader is bound, drawCalls and bytesUploaded are from the last frame
+    void Draw(int colorLocation, unsigned int drawCalls, unsigned int bytesUploaded);
+
+    // how much the last Draw sent to the gpu
+    unsigned int BytesUploaded() const { return (unsigned int)(m_Vertices.size() * sizeof(float)); }
+
+private:
+    void AddQuad(float x1, float y1, float x2, float y2);
+    void AddGraph(const float* samples, float top, float scale);
+    void AddNumber(unsigned int value, float x, float y);
+
+    unsigned int m_Buffer;
+    std::vector<float> m_Vertices; // kept between frames so drawing doesn't allocate
+    float m_FrameTimes[hudHistory];
+    float m_SimTimes[hudHistory];
+    unsigned int m_Next; // oldest sample, where the next one goes
+};
@@ -0,0 +1,21 @@
+#include "Input.h"
+
+void ApplyInput(PaddleInput& input, const InputEvent& event) {
+    if (event.key == INPUT_UP)
+        input.up = event.pressed;
+    if (event.key == INPUT_DOWN)
+        input.down = event.pressed;
+}
+
+void ConsumeInput(InputQueue& queue, PaddleInput& input, double time) {
+    while (const InputEvent* event = queue.Peek()) {
+        if (event->time > time) // belongs to a later tick
+            break;
+        ApplyInput(input, *event);
+        queue.Pop();
+    }
+}
+
+float InputVert(const PaddleInput& input) {
+    return (input.up ? paddleStep : 0.0f) - (input.down ? paddleStep : 0.0f);
+}
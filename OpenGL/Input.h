@@ -0,0 +1,32 @@
+#pragma once
+
+#include "SpscQueue.h"
+
+const float paddleStep = 0.01f; // how far a held key moves the paddle each tick
+
+enum InputKey {
+    INPUT_UP,
+    INPUT_DOWN
+};
+
+struct InputEvent {
+    double time; // when glfw reported it, in Now() seconds
+    InputKey key;
+    bool pressed;
+};
+
+typedef SpscQueue<InputEvent, 1024> InputQueue;
+
+// which keys are held, rebuilt from events so a missed release can't leave the paddle drifting
+struct PaddleInput {
+    bool up;
+    bool down;
+};
+
+void ApplyInput(PaddleInput& input, const InputEvent& event);
+
+// consumes every queued event that happened before time
+void ConsumeInput(InputQueue& queue, PaddleInput& input, double time);
+
+// paddle movement for one tick
+float InputVert(const PaddleInput& input);
@@ -0,0 +1,93 @@
+#include "JobSystem.h"
+
+static thread_local unsigned int threadIndex = 0; // workers set their own, everyone else is 0
+
+JobSystem::JobSystem(unsigned int threads)
+    : m_Generation(0), m_Busy(0), m_Stop(false), m_Body(nullptr), m_Count(0), m_Grain(1), m_Next(0) {
+    if (threads == 0)
+        threads = std::thread::hardware_concurrency();
+    if (threads == 0) // hardware_concurrency is allowed to not know
+        threads = 1;
+
+    for (unsigned int i = 1; i < threads; i++)
+        m_Workers.emplace_back(&JobSystem::Worker, this, i);
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Wake.notify_all();
+    for (std::thread& worker : m_Workers)
+        worker.join();
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0)
+        return;
+    if (grain == 0)
+        grain = 1;
+
+    // not worth waking anyone for a single chunk
+    if (m_Workers.empty() || count <= grain) {
+        body(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Body = &body;
+        m_Count = count;
+        m_Grain = grain;
+        m_Next = 0;
+        m_Busy = (unsigned int)m_Workers.size();
+        m_Generation++;
+    }
+    m_Wake.notify_all();
+
+    RunChunks();
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    m_Done.wait(lock, [this]() { return m_Busy == 0; });
+    m_Body = nullptr;
+}
+
+void JobSystem::RunChunks() {
+    // chunks are claimed one at a time so a slow thread doesn't hold up the rest
+    for (;;) {
+        size_t begin = m_Next.fetch_add(m_Grain);
+        if (begin >= m_Count)
+            return;
+        size_t end = begin + m_Grain < m_Count ? begin + m_Grain : m_Count;
+        (*m_Body)(begin, end);
+    }
+}
+
+unsigned int JobSystem::ThreadIndex() {
+    return threadIndex;
+}
+
+void JobSystem::Worker(unsigned int index) {
+    threadIndex = index;
+    unsigned int seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Wake.wait(lock, [&]() { return m_Stop || m_Generation != seen; });
+            if (m_Stop)
+                return;
+            seen = m_Generation;
+        }
+
+        RunChunks();
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            last = --m_Busy == 0;
+        }
+        if (last)
+            m_Done.notify_one();
+    }
+}
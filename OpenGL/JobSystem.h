@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// a fixed pool of worker threads for splitting a loop over many matches
+// the calling thread works on the loop too, so a pool of one thread is just a plain loop
+class JobSystem {
+public:
+    // threads counts the calling thread, 0 means one per hardware thread
+    explicit JobSystem(unsigned int threads = 0);
+    ~JobSystem();
+
+    // calls body(begin, end) on chunks of [0, count) of at most grain items and returns when all of them are done
+    // only one ParallelFor can run at a time
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    unsigned int ThreadCount() const { return (unsigned int)m_Workers.size() + 1; }
+
+    // which of the pool's threads is running the current chunk, from 0 for the calling thread to ThreadCount() - 1
+    // lets a body keep its own results per thread instead of sharing them
+    static unsigned int ThreadIndex();
+
+private:
+    void Worker(unsigned int index);
+    void RunChunks();
+
+    std::vector<std::thread> m_Workers;
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake; // workers wait here for the next loop
+    std::condition_variable m_Done; // ParallelFor waits here for the workers to finish
+    unsigned int m_Generation; // bumped for every loop so workers know there's new work
+    unsigned int m_Busy; // workers still inside the current loop
+    bool m_Stop;
+
+    // the loop being run
+    const std::function<void(size_t, size_t)>* m_Body;
+    size_t m_Count;
+    size_t m_Grain;
+    std::atomic<size_t> m_Next; // first item nobody has claimed yet
+};
@@ -2,208 +2,212 @@
 #include <GLFW/glfw3.h>
 
 #include <iostream>
-#include <fstream>
-#include <string>
-#include <sstream>
-#include <cmath>
-#include <cstdlib>
 #include <ctime>
+#include <cstring>
+#include <cstdlib>
+#include <atomic>
+#include <thread>
+
+#include "Renderer.h"
+#include "Scene.h"
+#include "Match.h"
+#include "TripleBuffer.h"
+#include "Timing.h"
+#include "Input.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "Hud.h"
+#include "Headless.h"
+#include "Replay.h"
+#include "SdfBatch.h"
+#include "Arena.h"
+#include "Paddle.h"
 
-#define ASSERT(x) if (!(x)) __debugbreak();
-#define GLCall(x) GLClearError();\
-    x;\
-    ASSERT(GLLogCall(#x, __FILE__, __LINE__))
-
-const double pi = 3.14159265358979323846;
-
-// error reporting
-
-static void GLClearError() {
-    while (glGetError() != GL_NO_ERROR);
+// handles key presses
+// key_callback only timestamps the event, the simulation thread applies it on the right tick
+InputQueue inputQueue;
+
+static void QueueKey(InputKey key, int action) {
+    if (action == GLFW_REPEAT)
+        return;
+    if (!inputQueue.Push({ Now(), key, action == GLFW_PRESS }))
+        std::cout << "[Input] queue full, dropped a key event" << std::endl;
 }
 
-static bool GLLogCall(const char* function, const char* file, int line) {
-    while (GLenum error = glGetError()) {
-        std::cout << "[OpenGL Error] (" << error << "):" << function << " " << file << ":" << line << std::endl;
-        return false;
-    }
-    return true;
+bool nextPacingMode = false; // p cycles through the frame pacing modes
+bool exportTrace = false; // t writes the profiler's ring buffer to trace.json
+bool showHud = false; // h toggles the performance overlay
+
+static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
+    if (key == GLFW_KEY_UP)
+        QueueKey(INPUT_UP, action);
+    if (key == GLFW_KEY_DOWN)
+        QueueKey(INPUT_DOWN, action);
+    if (key == GLFW_KEY_P && action == GLFW_PRESS)
+        nextPacingMode = true;
+    if (key == GLFW_KEY_T && action == GLFW_PRESS)
+        exportTrace = true;
+    if (key == GLFW_KEY_H && action == GLFW_PRESS)
+        showHud = !showHud;
 }
 
-// shaders
+// simulation thread
 
-struct ShaderProgramSource {
-    std::string VertexSource;
-    std::string FragmentSource;
+// what the simulation hands to the render thread
+struct Snapshot {
+    MatchState match;
+    EntityStore arena; // only filled in chaos mode
+    double time; // when this tick was due
+    float tickTime; // how long the tick took to run
 };
 
-static ShaderProgramSource ParseShader(const std::string& vertex, const std::string& fragment) {
-
-    std::ifstream vertexstream(vertex);
-    std::string vertexout;
-    if (vertexstream.is_open()) {
-        while (vertexstream) {
-            vertexout += vertexstream.get();
-        }
-    }
-
-    std::ifstream fragmentstream(fragment);
-    std::string fragmentout;
-    if (fragmentstream.is_open()) {
-        while (fragmentstream) {
-            fragmentout += fragmentstream.get();
+std::atomic<bool> running(true);
+TripleBuffer<Snapshot> states; // newest finished tick for the render thread
+Replay recording; // only touched by the simulation thread until it's joined
+bool record = false;
+unsigned int chaosBalls = 0; // plays an Arena with this many balls instead of the classic match when it isn't 0
+
+static void SimulationThread(StageTrace* trace) {
+    MatchState state;
+    InitMatch(state, recording.seed);
+
+    Arena arena;
+    if (chaosBalls)
+        InitArena(arena, chaosBalls, recording.seed);
+
+    PROFILE_THREAD("sim");
+
+    PaddleInput input = { false, false };
+    double next = Now();
+
+    states.Back().match = state;
+    states.Back().arena = arena.store;
+    states.Back().time = next;
+    states.Back().tickTime = 0.0f;
+    states.Publish();
+
+    while (running) {
+        // everything pressed before this tick was due gets applied to it
+        ConsumeInput(inputQueue, input, next);
+
+        trace->Begin();
+        double tickBegin = Now();
+        {
+            PROFILE_SCOPE("tick");
+            float vert = InputVert(input);
+            if (chaosBalls)
+                TickArena(arena, vert);
+            else
+                TickMatch(state, vert);
+            if (record)
+                recording.inputs.push_back(vert);
         }
+        states.Back().match = state;
+        if (chaosBalls)
+            states.Back().arena = arena.store; // reuses the snapshot's arrays, no allocation once they've grown
+        states.Back().time = next;
+        states.Back().tickTime = (float)(Now() - tickBegin);
+        states.Publish();
+        trace->End();
+
+        next += 1.0 / tickRate;
+        double now = Now();
+        if (now - next > 5.0 / tickRate) // fell too far behind, don't try to catch up
+            next = now;
+        std::this_thread::sleep_for(std::chrono::duration<double>(next - now));
     }
-
-    vertexout.resize(vertexout.size() - 1); // removes the last character from both strings because it was a weird character causing problems
-    fragmentout.resize(fragmentout.size() - 1);
-
-    return { vertexout, fragmentout };
 }
 
-static unsigned int CompileShader(unsigned int type, const std::string& source) {
-    unsigned int id = glCreateShader(type);
-    const char* src = source.c_str();
-    glShaderSource(id, 1, &src, nullptr);
-    glCompileShader(id);
-    
-    int result;
-    glGetShaderiv(id, GL_COMPILE_STATUS, &result);
-    if (result == GL_FALSE) {
-        int length;
-        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
-        char* message = (char*)_malloca(length * sizeof(char));
-        glGetShaderInfoLog(id, length, &length, message);
-        std::cout << "Failed to compile " << 
-            (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader" << std::endl;
-        std::cout << message << std::endl;
-        glDeleteShader(id);
-        return 0;
-    }
-    return id;
-}
+// low latency mode
 
-static unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader) {
-    unsigned int program = glCreateProgram();
-    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
-    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+// how far to move the player's paddle past the last tick, using the keys held right now
+// this gets read right before the paddle is drawn so a key press shows up this frame instead of the next
+static float LatchedOffset(GLFWwindow* window, const Snapshot& snapshot) {
+    glfwPollEvents();
+    PaddleInput input = { glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS, glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS };
 
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
-    glLinkProgram(program);
-    glValidateProgram(program);
+    double ticks = (Now() - snapshot.time) * tickRate; // how much of the next tick has already passed
+    if (ticks < 0.0)
+        ticks = 0.0;
+    if (ticks > 1.0)
+        ticks = 1.0;
 
-    glDeleteShader(vs);
-    glDeleteShader(fs);
+    float offset = InputVert(input) * (float)ticks;
 
-    return program;
+    // same limits as the clamp in TickMatch
+    const float* positions = snapshot.match.positions;
+    return ClampFloat(offset, -1.0f - positions[1], 1.0f - positions[5]);
 }
 
-// function to find the points of a regular polygon
-
-static float FindPoints(float size, unsigned int sides, unsigned int index, bool coord) {
-    if (coord) {
-        return (float) (size * cos(2 * pi * index / sides));
-    }
-    else {
-        return (float) (size * sin(2 * pi * index / sides) * 16 / 9);
-    }
+static void PrintUsage() {
+    std::cout << "Usage: OpenGL [--low-latency] [--frame-wait] [--sdf] [--pacing vsync|cap|uncapped|adaptive] [--cap fps] "
+        "[--headless frames] [--size width height] [--thumbnail path] [--capture path] [--replay path] [--batch-stress shapes] "
+        "[--balls n] [--record path]" << std::endl;
 }
 
-const float size = 0.025f; // size of the ball
-
-float positions[] = {
-    -0.98f, -0.20f, // player 1
-    -0.96f, -0.20f,
-    -0.96f,  0.20f,
-    -0.98f,  0.20f,
-     FindPoints(size, 8, 0, true), FindPoints(size, 8, 0, false), // 4 08, 09 ball
-     FindPoints(size, 8, 1, true), FindPoints(size, 8, 1, false), // 5 10, 11
-     FindPoints(size, 8, 2, true), FindPoints(size, 8, 2, false), // 6 12, 13
-     FindPoints(size, 8, 3, true), FindPoints(size, 8, 3, false), // 7 14, 15
-     FindPoints(size, 8, 4, true), FindPoints(size, 8, 4, false), // 8 16, 17
-     FindPoints(size, 8, 5, true), FindPoints(size, 8, 5, false), // 9 18, 19
-     FindPoints(size, 8, 6, true), FindPoints(size, 8, 6, false), // 10 20, 21
-     FindPoints(size, 8, 7, true), FindPoints(size, 8, 7, false), // 11 22, 23
-     0.98f, -0.20f, // player 2
-     0.96f, -0.20f,
-     0.96f,  0.20f,
-     0.98f,  0.20f,
-    -1.00f, -1.00f, // background
-     1.00f, -1.00f,
-     1.00f,  1.00f,
-    -1.00f,  1.00f
-};
-
-float start[] = {
-    -0.98f, -0.20f, // player 1
-    -0.96f, -0.20f,
-    -0.96f,  0.20f,
-    -0.98f,  0.20f,
-     FindPoints(size, 8, 0, true), FindPoints(size, 8, 0, false), // 4 08, 09 ball
-     FindPoints(size, 8, 1, true), FindPoints(size, 8, 1, false), // 5 10, 11
-     FindPoints(size, 8, 2, true), FindPoints(size, 8, 2, false), // 6 12, 13
-     FindPoints(size, 8, 3, true), FindPoints(size, 8, 3, false), // 7 14, 15
-     FindPoints(size, 8, 4, true), FindPoints(size, 8, 4, false), // 8 16, 17
-     FindPoints(size, 8, 5, true), FindPoints(size, 8, 5, false), // 9 18, 19
-     FindPoints(size, 8, 6, true), FindPoints(size, 8, 6, false), // 10 20, 21
-     FindPoints(size, 8, 7, true), FindPoints(size, 8, 7, false), // 11 22, 23
-     0.98f, -0.20f, // player 2
-     0.96f, -0.20f,
-     0.96f,  0.20f,
-     0.98f,  0.20f,
-    -1.00f, -1.00f, // background
-     1.00f, -1.00f,
-     1.00f,  1.00f,
-    -1.00f,  1.00f
-};
-
-// handles key presses
-float vert;
-
-static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-    if (key == GLFW_KEY_UP && action == GLFW_PRESS)
-        vert += 0.01f;
-    if (key == GLFW_KEY_UP && action == GLFW_RELEASE)
-        vert -= 0.01f;
-    if (key == GLFW_KEY_DOWN && action == GLFW_PRESS)
-        vert -= 0.01f;
-    if (key == GLFW_KEY_DOWN && action == GLFW_RELEASE)
-        vert += 0.01f;
-}
-
-// a function that returns true if a point is in a rectangle and false if it isn't
-static bool RectCollision(float x1, float y1, float x2, float y2, float x, float y) {
-    if (x > x1 and x < x2 and y > y1 and y < y2)
-        return true;
-    return false;
-}
-
-// checks collision for player 1
-static bool Player1Collision() {
-    for (int i = 8; i < 23; i += 2) {
-        if (RectCollision(positions[0], positions[1], positions[4], positions[5], positions[i], positions[i + 1]))
-            return true;
-    }
-    return false;
-}
+int main(int argc, char** argv)
+{
+    GLFWwindow* window;
 
-// checks collision for player 2
-static bool Player2Collision() {
-    for (int i = 8; i < 23; i += 2) {
-        if (RectCollision(positions[26], positions[27], positions[30], positions[31], positions[i], positions[i + 1]))
-            return true;
+    bool lowLatency = false; // latch input right before the player's paddle is drawn
+    bool frameWait = false; // sleep then spin until just before vsync instead of blocking in swap
+    bool sdfShapes = false; // draw the ball and paddles as distance field shapes instead of polygons
+    PacingMode pacing = PACING_VSYNC;
+    double capRate = 120.0; // frames per second in cap mode
+    bool headless = false;
+    unsigned int seed = static_cast<unsigned int>(std::time(nullptr)); // seeding with current time
+    HeadlessOptions headlessOptions = { 600, 320, 180, seed, nullptr, nullptr, nullptr, 0, false, 0 };
+    const char* recordPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--low-latency") == 0)
+            lowLatency = true;
+        else if (strcmp(argv[i], "--frame-wait") == 0)
+            frameWait = true;
+        else if (strcmp(argv[i], "--sdf") == 0)
+            sdfShapes = headlessOptions.sdf = true;
+        else if (strcmp(argv[i], "--pacing") == 0 && i + 1 < argc) {
+            if (!ParsePacingMode(argv[++i], pacing))
+                std::cout << "Unknown pacing mode " << argv[i] << std::endl;
+        }
+        else if (strcmp(argv[i], "--cap") == 0 && i + 1 < argc) {
+            capRate = atof(argv[++i]);
+            if (!(capRate > 0.0)) { // atof gives 0 for anything that isn't a number
+                std::cout << "Bad frame rate for --cap " << argv[i] << std::endl;
+                PrintUsage();
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--headless") == 0 && i + 1 < argc) {
+            headless = true;
+            headlessOptions.frames = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--size") == 0 && i + 2 < argc) {
+            headlessOptions.width = atoi(argv[++i]);
+            headlessOptions.height = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--thumbnail") == 0 && i + 1 < argc)
+            headlessOptions.thumbnail = argv[++i];
+        else if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc)
+            headlessOptions.capture = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            headless = true;
+            headlessOptions.replay = argv[++i];
+        }
+        else if (strcmp(argv[i], "--batch-stress") == 0 && i + 1 < argc) {
+            headless = true;
+            headlessOptions.stressShapes = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--balls") == 0 && i + 1 < argc)
+            chaosBalls = headlessOptions.balls = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            recordPath = argv[++i];
+        else
+            std::cout << "Unknown option " << argv[i] << std::endl;
     }
-    return false;
-}
-
-static void SetUniformColor(int location, unsigned char r, unsigned char g, unsigned char b) {
-    glUniform4f(location, (static_cast<GLfloat>(r) / 255), (static_cast<GLfloat>(g) / 255), (static_cast<GLfloat>(b) / 255), 1.0f);
-}
 
-int main(void)
-{
-    GLFWwindow* window;
+    if (headless)
+        return RunHeadless(headlessOptions);
 
     // Initialize the library
     if (!glfwInit())
@@ -220,258 +224,168 @@ int main(void)
     // Make the window's context current 
     glfwMakeContextCurrent(window);
 
-    glfwSwapInterval(1);
-
     if (glewInit() != GLEW_OK)
         std::cout << "Error" << std::endl;
 
-    std::srand(static_cast<unsigned int>(std::time(nullptr))); // initializing rand with current time
-
-    rand(); // wasing the first rand call
-
-    const float speedInc = 0.0001f;
-    float variance = 0.15f; // ammount of angle variance during a bounce
-    float ballAngle = (float)((pi * ((2 * rand()) + 98301)) / 131068);
-
-    if ((ballAngle < (3 * pi / 4)) || (ballAngle > (5 * pi / 4)))
-        ballAngle = 3.0f;
+    Scene scene;
+    CreateScene(scene);
+    Renderer renderer;
+    CommandBuffer commands;
 
-    float ballSpeed = 0.005f;
-    bool collision = false;
+    int windowWidth, windowHeight;
+    glfwGetFramebufferSize(window, &windowWidth, &windowHeight);
+    SdfBatch sdf(windowWidth, windowHeight);
 
-    unsigned int timer = 0;
-
-    unsigned int background[] = {
-        16, 17, 18,
-        18, 19, 16
-    };
-
-    unsigned int ball[] = {
-        4, 6, 5,
-        4, 7, 6,
-        4, 8, 7,
-        4, 9, 8,
-        4, 10, 9,
-        4, 11, 10
-    };
-
-    unsigned int player1[] = { // must be unsigned
-        0, 1, 2,
-        2, 3, 0
-    };
-
-    unsigned int player2[] = {
-        12, 13, 14,
-        14, 15, 12
-    };
-
-    unsigned int buffer;
-    glGenBuffers(1, &buffer);
-    glBindBuffer(GL_ARRAY_BUFFER, buffer);
-    glBufferData(GL_ARRAY_BUFFER, 20 * 2 * sizeof(float), positions, GL_DYNAMIC_DRAW); // change to dynamic when moving
+    glfwSetKeyCallback(window, key_callback);
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, 0);
+    StageTrace simTrace("sim");
+    StageTrace renderTrace("render");
+    StageTrace swapTrace("swap");
 
-    unsigned int backgroundibo;
-    glGenBuffers(1, &backgroundibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, backgroundibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, 2 * 3 * sizeof(unsigned int), background, GL_STATIC_DRAW); // change to dynamic when moving
+    recording.seed = seed;
+    record = recordPath != nullptr && !chaosBalls; // replays only drive the classic match
 
-    unsigned int ballibo;
-    glGenBuffers(1, &ballibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ballibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, 6 * 3 * sizeof(unsigned int), ball, GL_STATIC_DRAW); // change to dynamic when moving
+    std::thread simulation(SimulationThread, &simTrace);
 
-    unsigned int player1ibo;
-    glGenBuffers(1, &player1ibo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, player1ibo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, 2 * 3 * sizeof(unsigned int), player1, GL_STATIC_DRAW); // change to dynamic when moving
+    while (!states.Update()) // wait for the first tick
+        std::this_thread::yield();
 
-    unsigned int player2ibo;
-    GLCall(glGenBuffers(1, &player2ibo));
-    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, player2ibo));
-    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, 2 * 3 * sizeof(unsigned int), player2, GL_STATIC_DRAW)); // change to dynamic when moving
+    double refreshRate = 60.0;
+    if (const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor()))
+        refreshRate = mode->refreshRate;
 
-    ShaderProgramSource source = ParseShader("res/shaders/Vertex.shader", "res/shaders/Fragment.shader"); // get shaders from files
+    FramePacer pacer(pacing, refreshRate, capRate);
 
-    unsigned int shader = CreateShader(source.VertexSource, source.FragmentSource); // compile shaders
-    glUseProgram(shader);
+    double lastSwap = Now();
+    double renderCost = 0.002; // running average of how long a frame takes to draw
 
-    int location = glGetUniformLocation(shader, "u_Color");
-    ASSERT(location != -1); //location of -1 means it couldn't be found
-    SetUniformColor(location, 0, 0, 0); // init to black
-    //glUniform4f(location, (static_cast<GLfloat>(0) / 255), (static_cast<GLfloat>(29) / 255), (static_cast<GLfloat>(102) / 255), 1.0f); // 0, 29, 102 or #001d66
+    Hud hud;
+    unsigned int lastDrawCalls = 0;
+    unsigned int lastBytesUploaded = 0;
 
-    // unbind everything
-    //glUseProgram(0);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
-
-    glfwSetKeyCallback(window, key_callback);
+    PROFILE_THREAD("render");
 
     // Loop until the user closes the window
     while (!glfwWindowShouldClose(window))
     {
-        // Render here
-        glClear(GL_COLOR_BUFFER_BIT);
-
-        // moving player
-        for (int i = 1; i < 8; i += 2) {
-            positions[i] += vert;
+        if (nextPacingMode) {
+            pacer.SetMode((PacingMode)((pacer.Mode() + 1) % PACING_MODE_COUNT));
+            std::cout << "[Pacing] " << PacingModeName(pacer.Mode()) << std::endl;
+            nextPacingMode = false;
         }
 
-        // preventing player from going offscreen
-        while (positions[5] > 1.0f) {
-            for (int i = 1; i < 8; i += 2) {
-                positions[i] -= 0.01f;
-            }
-        }
-        while (positions[1] < -1.0f) {
-            for (int i = 1; i < 8; i += 2) {
-                positions[i] += 0.01f;
-            }
-        }
+        PROFILE_SCOPE("frame");
 
-        // moving bot
-        if (((((positions[25] + positions[29]) / 2) > positions[9]) && positions[8] > 0) && ((ballAngle < (pi / 2)) || (ballAngle > (3 * pi / 2)))) {
-            for (int i = 25; i < 32; i += 2) {
-                positions[i] -= 0.01f;
-            }
-        }
+        // wake up just early enough to draw before the next vblank
+        if (frameWait)
+            SleepUntil(lastSwap + 1.0 / refreshRate - renderCost - 0.001);
 
-        if (((((positions[25] + positions[29]) / 2) < positions[9]) && positions[8] > 0) && ((ballAngle < (pi / 2)) || (ballAngle > (3 * pi / 2)))) {
-            for (int i = 25; i < 32; i += 2) {
-                positions[i] += 0.01f;
-            }
-        }
+        renderTrace.Begin();
+        double renderBegin = Now();
 
-        // clamp player
-        while (positions[5] > 1.0f) {
-            for (int i = 1; i < 8; i += 2) {
-                positions[i] -= 0.01f;
-            }
-        }
-        while (positions[1] < -1.0f) {
-            for (int i = 1; i < 8; i += 2) {
-                positions[i] += 0.01f;
-            }
-        }
+        // always draw the newest tick the simulation has finished
+        states.Update();
+        const Snapshot& snapshot = states.Front();
+        const float* positions = snapshot.match.positions;
 
-        //clamp bot
-        while (positions[29] > 1.0f) {
-            for (int i = 25; i < 32; i += 2) {
-                positions[i] -= 0.01f;
-            }
-        }
-        while (positions[25] < -1.0f) {
-            for (int i = 25; i < 32; i += 2) {
-                positions[i] += 0.01f;
-            }
-        }
-
-        // ball collision
-        // check top and bottom
-        collision = false;
-        for (int i = 9; i < 24; i += 2) {
-            if (positions[i] > 1.0f || positions[i] < -1.0f) {
-                collision = true;
-            }
-        }
-        if (collision) {
-            ballAngle = (float)(2 * pi) - ballAngle;
-            //ballAngle += (rand() / (32767 / variance)) - (variance / 2);
-        }
+        // Render here
+        glClear(GL_COLOR_BUFFER_BIT);
 
-        collision = false;
+        renderer.ResetStats();
+        sdf.ResetStats();
 
-        //clamp angle
-        if (ballAngle > 2 * pi)
-            ballAngle -= (float)(2 * pi);
-        if (ballAngle < 0)
-            ballAngle += (float)(2 * pi);
+        UploadScene(scene, positions);
+        if (chaosBalls) {
+            PROFILE_SCOPE("draw arena");
+            PROFILE_GPU_SCOPE("draw arena");
 
-        // check paddle
-        if ((Player1Collision() && (ballAngle > (pi / 2)) && (ballAngle < (3 * pi / 2))) || (Player2Collision() && ((ballAngle < (pi / 2)) || (ballAngle > (3 * pi / 2))))) {
-            ballAngle = (float) pi - ballAngle;
-            //ballAngle += (rand() / (32767 / variance)) - (variance / 2);
-            ballSpeed += speedInc;
+            RecordBackground(scene, commands);
+            renderer.Submit(commands);
+            DrawEntities(snapshot.arena, sdf);
+            sdf.Flush();
         }
+        else if (sdfShapes) {
+            PROFILE_SCOPE("draw scene");
+            PROFILE_GPU_SCOPE("draw scene");
 
-        // clamp angle
-        if (ballAngle > 2 * pi)
-            ballAngle -= (float)(2 * pi);
-        if (ballAngle < 0)
-            ballAngle += (float)(2 * pi);
-
-        //check oob
-        collision = false;
-        for (int i = 8; i < 23; i += 2) {
-            if (positions[i] > 1.0f || positions[i] < -1.0f) {
-                timer = 0;
-            }
+            RecordBackground(scene, commands);
+            renderer.Submit(commands);
+            DrawShapesSdf(sdf, positions, lowLatency ? LatchedOffset(window, snapshot) : 0.0f);
         }
+        else {
+            {
+                PROFILE_SCOPE("draw scene");
+                PROFILE_GPU_SCOPE("draw scene");
 
-        // reset if oob
-        if (timer == 0) {
-            for (int i = 0; i < 32; i++) {
-                positions[i] = start[i];
+                RecordScene(scene, commands);
+                renderer.Submit(commands);
             }
-            ballAngle = (float) (((rand() + 16383.5) * pi) / 32767);
-            ballSpeed = 0.005f;
-        }
 
-        // start
-        if (timer > 100) {
-            for (int i = 8; i < 23; i += 2) {
-                positions[i] += cos(ballAngle) * ballSpeed;
-            }
-            for (int i = 9; i < 24; i += 2) {
-                positions[i] += sin(ballAngle) * ballSpeed;
+            // player 1 goes last so its input can be sampled as late as possible
+            {
+                PROFILE_SCOPE("draw player 1");
+                PROFILE_GPU_SCOPE("draw player 1");
+
+                RecordPlayer1(scene, commands, lowLatency ? LatchedOffset(window, snapshot) : 0.0f);
+                renderer.Submit(commands);
             }
         }
 
-        //glUseProgram(shader);
-        //glUniform4f(location, (static_cast<GLfloat>(0) / 255), (static_cast<GLfloat>(29) / 255), (static_cast<GLfloat>(102) / 255), 1.0f); // 0, 29, 102 or #001d66
-
-        glBindBuffer(GL_ARRAY_BUFFER, buffer);
-        glBufferData(GL_ARRAY_BUFFER, 20 * 2 * sizeof(float), positions, GL_DYNAMIC_DRAW);
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, 0);
-
+        unsigned int drawCalls = renderer.DrawCalls() + sdf.DrawCalls();
+        unsigned int bytesUploaded = floatCount * sizeof(float) + sdf.BytesUploaded();
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, backgroundibo);
-        SetUniformColor(location, 0, 29, 102);
+        if (showHud) {
+            PROFILE_SCOPE("draw hud");
+            PROFILE_GPU_SCOPE("draw hud");
 
-        GLCall(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr));
-
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ballibo);
-        SetUniformColor(location, 255, 255, 255);
-
-        GLCall(glDrawElements(GL_TRIANGLES, 18, GL_UNSIGNED_INT, nullptr));
+            hud.Draw(scene.location, lastDrawCalls, lastBytesUploaded);
+            drawCalls++;
+            bytesUploaded += hud.BytesUploaded();
+        }
 
+        lastDrawCalls = drawCalls;
+        lastBytesUploaded = bytesUploaded;
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, player1ibo);
-        SetUniformColor(location, 0, 140, 255);
+        renderTrace.End();
+        renderCost = renderCost * 0.9 + (Now() - renderBegin) * 0.1;
 
-        GLCall(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr));
+        pacer.Wait();
 
+        // Swap front and back buffers
+        swapTrace.Begin();
+        {
+            PROFILE_SCOPE("swap");
+            glfwSwapBuffers(window);
+        }
+        swapTrace.End();
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, player2ibo);
+        double swapEnd = Now();
+        hud.AddFrame((float)(swapEnd - lastSwap), snapshot.tickTime);
+        lastSwap = swapEnd;
 
-        GLCall(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr));
+        PROFILE_FRAME();
+        if (exportTrace) {
+            PROFILE_EXPORT("trace.json");
+            exportTrace = false;
+        }
 
-        // Swap front and back buffers
-        glfwSwapBuffers(window);
+        pacer.FrameDone();
 
         // Poll for and process events
         glfwPollEvents();
-
-        timer++;
     }
 
-    glDeleteProgram(shader);
+    running = false;
+    simulation.join();
+
+    if (record)
+        SaveReplay(recordPath, recording);
+
+    PrintOverlap(simTrace, renderTrace);
+    PrintOverlap(simTrace, swapTrace);
+    pacer.Report();
+
+    glDeleteProgram(scene.shader);
 
     glfwTerminate();
     return 0;
@@ -0,0 +1,251 @@
+#include "Match.h"
+#include "Mesh.h"
+#include "Paddle.h"
+
+#include <cmath>
+
+// the ball's corners, stretched so it looks round on a 16:9 window
+static constexpr std::array<float, 16> ballVertices = PolygonVertices<8>(size);
+
+const float start[floatCount] = {
+    -0.98f, -0.20f, // player 1
+    -0.96f, -0.20f,
+    -0.96f,  0.20f,
+    -0.98f,  0.20f,
+     ballVertices[0], ballVertices[1], // 4 08, 09 ball
+     ballVertices[2], ballVertices[3], // 5 10, 11
+     ballVertices[4], ballVertices[5], // 6 12, 13
+     ballVertices[6], ballVertices[7], // 7 14, 15
+     ballVertices[8], ballVertices[9], // 8 16, 17
+     ballVertices[10], ballVertices[11], // 9 18, 19
+     ballVertices[12], ballVertices[13], // 10 20, 21
+     ballVertices[14], ballVertices[15], // 11 22, 23
+     0.98f, -0.20f, // player 2
+     0.96f, -0.20f,
+     0.96f,  0.20f,
+     0.98f,  0.20f,
+    -1.00f, -1.00f, // background
+     1.00f, -1.00f,
+     1.00f,  1.00f,
+    -1.00f,  1.00f
+};
+
+int LcgRand(unsigned int& seed) {
+    seed = seed * 214013u + 2531011u;
+    return (int)((seed >> 16) & 0x7fff);
+}
+
+int MatchRand(MatchState& state) {
+    return LcgRand(state.seed);
+}
+
+void StartPositions(const MatchRules& rules, float* positions) {
+    for (unsigned int i = 0; i < floatCount; i++) {
+        positions[i] = start[i];
+    }
+
+    // half of 0.40f is exactly 0.20f so the classic paddles come out the same
+    for (int i = 1; i < 8; i += 2) {
+        positions[i] = i < 4 ? -rules.paddleLength / 2 : rules.paddleLength / 2;
+        positions[i + 24] = positions[i];
+    }
+
+    if (rules.ballSize != size) {
+        std::array<float, 16> vertices = PolygonVertices<8>(rules.ballSize);
+        for (int i = 0; i < 16; i++) {
+            positions[i + 8] = vertices[i];
+        }
+    }
+}
+
+void InitMatch(MatchState& state, unsigned int seed, const MatchRules& rules) {
+    state.rules = rules;
+    StartPositions(rules, state.positions);
+
+    state.seed = seed;
+    MatchRand(state); // wasing the first rand call
+
+    state.ballAngle = (float)((pi * ((2 * MatchRand(state)) + 98301)) / 131068);
+
+    if ((state.ballAngle < (3 * pi / 4)) || (state.ballAngle > (5 * pi / 4)))
+        state.ballAngle = 3.0f;
+
+    state.ballSpeed = 0.005f;
+    state.timer = 0;
+    state.score[0] = 0;
+    state.score[1] = 0;
+    state.ticks = 0;
+}
+
+// a function that returns true if a point is in a rectangle and false if it isn't
+bool RectCollision(float x1, float y1, float x2, float y2, float x, float y) {
+    if (x > x1 and x < x2 and y > y1 and y < y2)
+        return true;
+    return false;
+}
+
+// checks collision for player 1
+bool Player1Collision(const float* positions) {
+    for (int i = 8; i < 23; i += 2) {
+        if (RectCollision(positions[0], positions[1], positions[4], positions[5], positions[i], positions[i + 1]))
+            return true;
+    }
+    return false;
+}
+
+// checks collision for player 2
+bool Player2Collision(const float* positions) {
+    for (int i = 8; i < 23; i += 2) {
+        if (RectCollision(positions[26], positions[27], positions[30], positions[31], positions[i], positions[i + 1]))
+            return true;
+    }
+    return false;
+}
+
+// the y of a paddle's first vertex, the other three follow every second float
+static int PaddleFirstY(MatchSide side) {
+    return side == SIDE_LEFT ? 1 : 25;
+}
+
+void MovePaddle(MatchState& state, MatchSide side, float vert) {
+    const int first = PaddleFirstY(side);
+    for (int i = first; i < first + 8; i += 2) {
+        state.positions[i] += vert;
+    }
+}
+
+void ClampPaddle(MatchState& state, MatchSide side) {
+    // in the same 0.01 steps the old clamp loops took so replays still line up
+    const int first = PaddleFirstY(side);
+    MovePaddle(state, side, SnappedCorrection(state.positions[first], state.positions[first + 4], -1.0f, 1.0f, 0.01f));
+}
+
+void TrackStep(MatchState& state, MatchSide side) {
+    float* positions = state.positions;
+    float ballAngle = state.ballAngle;
+    const int first = PaddleFirstY(side);
+
+    // only once the ball is on this paddle's half and heading for it
+    bool headingRight = (ballAngle < (pi / 2)) || (ballAngle > (3 * pi / 2));
+    bool coming = side == SIDE_RIGHT ? positions[8] > 0 && headingRight : positions[8] < 0 && !headingRight;
+
+    if ((((positions[first] + positions[first + 4]) / 2) > positions[9]) && coming) {
+        for (int i = first; i < first + 8; i += 2) {
+            positions[i] -= 0.01f;
+        }
+    }
+
+    if ((((positions[first] + positions[first + 4]) / 2) < positions[9]) && coming) {
+        for (int i = first; i < first + 8; i += 2) {
+            positions[i] += 0.01f;
+        }
+    }
+}
+
+void BotStep(MatchState& state) {
+    TrackStep(state, SIDE_RIGHT);
+}
+
+void ResetRound(MatchState& state) {
+    StartPositions(state.rules, state.positions);
+    state.ballAngle = (float) (((MatchRand(state) + 16383.5) * pi) / 32767);
+    state.ballSpeed = 0.005f;
+}
+
+bool MatchOver(const MatchState& state) {
+    return state.score[0] >= pointsToWin || state.score[1] >= pointsToWin || state.ticks >= maxMatchTicks;
+}
+
+void TickBall(MatchState& state) {
+    const float speedInc = state.rules.speedInc;
+    const float variance = state.rules.variance; // ammount of angle variance during a bounce
+    float* positions = state.positions;
+    float& ballAngle = state.ballAngle;
+    bool collision = false;
+
+    // ball collision
+    // check top and bottom
+    collision = false;
+    for (int i = 9; i < 24; i += 2) {
+        if (positions[i] > 1.0f || positions[i] < -1.0f) {
+            collision = true;
+        }
+    }
+    if (collision) {
+        ballAngle = (float)(2 * pi) - ballAngle;
+        if (variance != 0.0f)
+            ballAngle += (MatchRand(state) / (32767 / variance)) - (variance / 2);
+    }
+
+    collision = false;
+
+    //clamp angle
+    if (ballAngle > 2 * pi)
+        ballAngle -= (float)(2 * pi);
+    if (ballAngle < 0)
+        ballAngle += (float)(2 * pi);
+
+    // check paddle
+    if ((Player1Collision(positions) && (ballAngle > (pi / 2)) && (ballAngle < (3 * pi / 2))) || (Player2Collision(positions) && ((ballAngle < (pi / 2)) || (ballAngle > (3 * pi / 2))))) {
+        ballAngle = (float) pi - ballAngle;
+        if (variance != 0.0f)
+            ballAngle += (MatchRand(state) / (32767 / variance)) - (variance / 2);
+        state.ballSpeed += speedInc;
+    }
+
+    // clamp angle
+    if (ballAngle > 2 * pi)
+        ballAngle -= (float)(2 * pi);
+    if (ballAngle < 0)
+        ballAngle += (float)(2 * pi);
+
+    //check oob
+    int out = 0; // 1 if the ball left past player 2, -1 if it left past player 1
+    for (int i = 8; i < 23; i += 2) {
+        if (positions[i] > 1.0f)
+            out = 1;
+        if (positions[i] < -1.0f)
+            out = -1;
+    }
+    if (out != 0) {
+        state.timer = 0;
+        state.score[out > 0 ? 0 : 1]++;
+    }
+
+    // reset if oob
+    if (state.timer == 0) {
+        ResetRound(state);
+    }
+
+    // start
+    if (state.timer > 100) {
+        // worked out once for all the vertices, auto keeps the exact types the per vertex version had so replays still line up
+        const auto dx = cos(ballAngle) * state.ballSpeed;
+        const auto dy = sin(ballAngle) * state.ballSpeed;
+        for (int i = 8; i < 23; i += 2) {
+            positions[i] += dx;
+        }
+        for (int i = 9; i < 24; i += 2) {
+            positions[i] += dy;
+        }
+    }
+
+    state.timer++;
+    state.ticks++;
+}
+
+void TickMatch(MatchState& state, float vert) {
+    // moving player
+    MovePaddle(state, SIDE_LEFT, vert);
+
+    // preventing player from going offscreen
+    ClampPaddle(state, SIDE_LEFT);
+
+    // moving bot
+    BotStep(state);
+
+    //clamp bot
+    ClampPaddle(state, SIDE_RIGHT);
+
+    TickBall(state);
+}
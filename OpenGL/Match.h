@@ -0,0 +1,77 @@
+#pragma once
+
+constexpr double pi = 3.14159265358979323846;
+
+constexpr float size = 0.025f; // size of the ball
+
+const unsigned int vertexCount = 20; // paddles, ball and background
+const unsigned int floatCount = vertexCount * 2;
+
+const double tickRate = 60.0; // ticks per second, the game was tuned at one tick per 60hz frame
+
+const unsigned int pointsToWin = 11;
+const unsigned int maxMatchTicks = 100000; // about half an hour at 60hz, near vertical serves can bounce around forever so call it a draw
+
+// what a match is played with, the defaults are the classic game and play out exactly as before
+struct MatchRules {
+    float speedInc = 0.0001f; // added to the ball's speed by every paddle hit
+    float variance = 0.0f; // spread of the random nudge to the angle at every bounce, none takes no rand calls
+    float ballSize = size;
+    float paddleLength = 0.40f;
+};
+
+// everything the simulation needs to advance a match by one tick
+struct MatchState {
+    float positions[floatCount];
+    float ballAngle;
+    float ballSpeed;
+    unsigned int timer;
+    unsigned int seed; // the match's own rand state so threads don't share one
+    unsigned int score[2];
+    unsigned int ticks; // since the match started
+    MatchRules rules;
+};
+
+extern const float start[floatCount];
+
+// same generator as the msvc rand() so seeded matches play out the same as before
+int LcgRand(unsigned int& seed);
+int MatchRand(MatchState& state);
+
+void InitMatch(MatchState& state, unsigned int seed, const MatchRules& rules = MatchRules());
+
+bool RectCollision(float x1, float y1, float x2, float y2, float x, float y);
+bool Player1Collision(const float* positions);
+bool Player2Collision(const float* positions);
+
+enum MatchSide {
+    SIDE_LEFT, // player 1
+    SIDE_RIGHT // the bot in the classic match
+};
+
+// shifts a paddle up by vert, without keeping it on screen
+void MovePaddle(MatchState& state, MatchSide side, float vert);
+
+// pushes a paddle back on screen
+void ClampPaddle(MatchState& state, MatchSide side);
+
+// moves a paddle one step towards the ball when the ball is coming at it
+void TrackStep(MatchState& state, MatchSide side);
+
+// the classic bot, TrackStep for the right paddle
+void BotStep(MatchState& state);
+
+// where the paddles and ball start with these rules, start for the classic ones
+void StartPositions(const MatchRules& rules, float* positions);
+
+// puts the paddles and ball back where they started and serves a new ball
+void ResetRound(MatchState& state);
+
+bool MatchOver(const MatchState& state);
+
+// everything in a tick after the paddles have moved: bounces, scoring, serving and moving the ball
+void TickBall(MatchState& state);
+
+// advances the match by one tick, vert is how far the player moves this tick
+// player 1 against the classic bot, see Policies.h for other controllers
+void TickMatch(MatchState& state, float vert);
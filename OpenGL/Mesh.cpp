@@ -0,0 +1,37 @@
+#include "Mesh.h"
+
+// constexpr so they're baked into the binary instead of filled in before main
+static constexpr std::array<float, 8 * 2> circle8 = PolygonVertices<8>(1.0f, 1.0);
+static constexpr std::array<float, 16 * 2> circle16 = PolygonVertices<16>(1.0f, 1.0);
+static constexpr std::array<float, 64 * 2> circle64 = PolygonVertices<64>(1.0f, 1.0);
+
+static constexpr std::array<unsigned int, 6 * 3> circle8Indices = PolygonIndices<8>();
+static constexpr std::array<unsigned int, 14 * 3> circle16Indices = PolygonIndices<16>();
+static constexpr std::array<unsigned int, 62 * 3> circle64Indices = PolygonIndices<64>();
+
+MeshView CircleMesh(CircleLod lod) {
+    switch (lod) {
+    case CIRCLE_8:
+        return { circle8.data(), 8, circle8Indices.data(), (unsigned int)circle8Indices.size() };
+    case CIRCLE_16:
+        return { circle16.data(), 16, circle16Indices.data(), (unsigned int)circle16Indices.size() };
+    default:
+        return { circle64.data(), 64, circle64Indices.data(), (unsigned int)circle64Indices.size() };
+    }
+}
+
+bool FindCircleLod(unsigned int sides, CircleLod& lod) {
+    switch (sides) {
+    case 8:
+        lod = CIRCLE_8;
+        return true;
+    case 16:
+        lod = CIRCLE_16;
+        return true;
+    case 64:
+        lod = CIRCLE_64;
+        return true;
+    default:
+        return false;
+    }
+}
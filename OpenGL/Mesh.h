@@ -0,0 +1,147 @@
+#pragma once
+
+#include <array>
+
+#include "Match.h"
+
+// meshes worked out by the compiler, nothing here runs at startup
+
+// sin and cos that can run at compile time
+// the angle is brought into [-pi/4, pi/4] with pi/2 split into parts that multiply exactly (fdlibm's constants)
+// so angles that land on an axis give the same tiny leftovers std::cos and std::sin do instead of noise
+struct ConstAngle {
+    double r; // what's left after taking out quarter turns
+    int quadrant; // how many quarter turns were taken out, 0 to 3
+};
+
+constexpr ConstAngle ReduceAngle(double x) {
+    const double pio2_1 = 1.57079632673412561417e+00;
+    const double pio2_2 = 6.07710050630396597660e-11;
+    const double pio2_3 = 2.02226624871116645580e-21;
+    const double pio2_3t = 8.47842766036889956997e-32;
+
+    double k = x / (pi / 2);
+    long long n = (long long)(k < 0 ? k - 0.5 : k + 0.5);
+    double r = x - n * pio2_1 - n * pio2_2 - n * pio2_3 - n * pio2_3t;
+    return { r, (int)(((n % 4) + 4) % 4) };
+}
+
+// taylor series, plenty of terms for |r| <= pi/4
+constexpr double SinKernel(double r) {
+    double term = r, sum = r;
+    for (int n = 1; n < 12; n++) {
+        term *= -r * r / ((2.0 * n) * (2.0 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double CosKernel(double r) {
+    double term = 1.0, sum = 1.0;
+    for (int n = 1; n < 12; n++) {
+        term *= -r * r / ((2.0 * n - 1) * (2.0 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double ConstSin(double x) {
+    ConstAngle a = ReduceAngle(x);
+    switch (a.quadrant) {
+    case 0: return SinKernel(a.r);
+    case 1: return CosKernel(a.r);
+    case 2: return -SinKernel(a.r);
+    default: return -CosKernel(a.r);
+    }
+}
+
+constexpr double ConstCos(double x) {
+    ConstAngle a = ReduceAngle(x);
+    switch (a.quadrant) {
+    case 0: return CosKernel(a.r);
+    case 1: return -SinKernel(a.r);
+    case 2: return -CosKernel(a.r);
+    default: return SinKernel(a.r);
+    }
+}
+
+// corners of a regular polygon as x, y pairs starting at angle 0
+// y gets stretched by aspect so it comes out regular on a window that shape
+template <unsigned int Sides>
+constexpr std::array<float, Sides * 2> PolygonVertices(float radius, double aspect = 16.0 / 9) {
+    static_assert(Sides >= 3, "a polygon needs at least 3 sides");
+    std::array<float, Sides * 2> vertices = {};
+    for (unsigned int i = 0; i < Sides; i++) {
+        // start[] used to get the ball's corners from cos and sin at startup, these come out with the same bits
+        vertices[i * 2] = (float)(radius * ConstCos(2 * pi * i / Sides));
+        vertices[i * 2 + 1] = (float)(radius * ConstSin(2 * pi * i / Sides) * aspect);
+    }
+    return vertices;
+}
+
+// triangle fan over any convex outline, first is the index of its first vertex in the buffer
+template <unsigned int Corners>
+constexpr std::array<unsigned int, (Corners - 2) * 3> FanIndices(unsigned int first = 0) {
+    static_assert(Corners >= 3, "a fan needs at least 3 corners");
+    std::array<unsigned int, (Corners - 2) * 3> indices = {};
+    for (unsigned int i = 0; i < Corners - 2; i++) {
+        indices[i * 3] = first;
+        indices[i * 3 + 1] = first + i + 2;
+        indices[i * 3 + 2] = first + i + 1;
+    }
+    return indices;
+}
+
+template <unsigned int Sides>
+constexpr std::array<unsigned int, (Sides - 2) * 3> PolygonIndices(unsigned int first = 0) {
+    return FanIndices<Sides>(first);
+}
+
+// rounded rectangle centered on 0, 0 with CornerSides segments around each corner
+// radius is along x like the half sizes, y gets stretched by aspect
+template <unsigned int CornerSides>
+constexpr std::array<float, (CornerSides + 1) * 8> RoundedRectVertices(float halfWidth, float halfHeight, float radius, double aspect = 16.0 / 9) {
+    std::array<float, (CornerSides + 1) * 8> vertices = {};
+    const float centers[4][2] = {
+        { halfWidth - radius, halfHeight - radius },
+        { -halfWidth + radius, halfHeight - radius },
+        { -halfWidth + radius, -halfHeight + radius },
+        { halfWidth - radius, -halfHeight + radius }
+    };
+    unsigned int v = 0;
+    for (unsigned int corner = 0; corner < 4; corner++) {
+        // each corner sweeps a quarter turn, starting where the last one ended
+        for (unsigned int i = 0; i <= CornerSides; i++) {
+            double angle = pi / 2 * corner + pi / 2 * i / CornerSides;
+            vertices[v++] = (float)(centers[corner][0] + radius * ConstCos(angle));
+            vertices[v++] = (float)(centers[corner][1] + radius * ConstSin(angle) * aspect);
+        }
+    }
+    return vertices;
+}
+
+template <unsigned int CornerSides>
+constexpr std::array<unsigned int, ((CornerSides + 1) * 4 - 2) * 3> RoundedRectIndices(unsigned int first = 0) {
+    return FanIndices<(CornerSides + 1) * 4>(first);
+}
+
+// a mesh picked at runtime, pointing into one of the arrays above
+struct MeshView {
+    const float* vertices; // x, y pairs
+    unsigned int vertexCount;
+    const unsigned int* indices;
+    unsigned int indexCount;
+};
+
+enum CircleLod {
+    CIRCLE_8,
+    CIRCLE_16,
+    CIRCLE_64,
+    CIRCLE_LOD_COUNT
+};
+
+// radius 1 circle with no aspect stretch
+MeshView CircleMesh(CircleLod lod);
+
+// the lod with exactly that many sides, false if there isn't one
+bool FindCircleLod(unsigned int sides, CircleLod& lod);
@@ -0,0 +1,374 @@
+#include "Mlp.h"
+
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cmath>
+
+#include "Cpu.h"
+#include "Match.h"
+
+#ifdef CPU_X86
+#include <immintrin.h>
+#endif
+
+const unsigned int mlpMagic = 0x20504C4D; // "MLP "
+const unsigned int mlpVersion = 1;
+const unsigned int maxLayerSize = 1 << 16; // anything bigger in a file means it's broken
+
+void InitMlp(Mlp& mlp, const std::vector<unsigned int>& sizes, unsigned int seed) {
+    mlp.layers.clear();
+    mlp.useQuantized = false;
+    for (size_t l = 0; l + 1 < sizes.size(); l++) {
+        MlpLayer layer;
+        layer.inputs = sizes[l];
+        layer.outputs = sizes[l + 1];
+        layer.activation = l + 2 == sizes.size() ? MLP_TANH : MLP_RELU;
+
+        float limit = std::sqrt(6.0f / (layer.inputs + layer.outputs));
+        layer.weights.resize((size_t)layer.inputs * layer.outputs);
+        for (float& weight : layer.weights)
+            weight = (LcgRand(seed) / 16383.5f - 1.0f) * limit;
+        layer.bias.assign(layer.outputs, 0.0f);
+        mlp.layers.push_back(layer);
+    }
+}
+
+unsigned int MlpInputs(const Mlp& mlp) {
+    return mlp.layers.empty() ? 0 : mlp.layers.front().inputs;
+}
+
+unsigned int MlpOutputs(const Mlp& mlp) {
+    return mlp.layers.empty() ? 0 : mlp.layers.back().outputs;
+}
+
+bool SaveMlp(const char* path, const Mlp& mlp) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cout << "[Mlp] couldn't write " << path << std::endl;
+        return false;
+    }
+
+    unsigned int header[] = { mlpMagic, mlpVersion, (unsigned int)mlp.layers.size() };
+    out.write((const char*)header, sizeof(header));
+    for (const MlpLayer& layer : mlp.layers) {
+        unsigned int sizes[] = { layer.inputs, layer.outputs, (unsigned int)layer.activation };
+        out.write((const char*)sizes, sizeof(sizes));
+        out.write((const char*)layer.weights.data(), layer.weights.size() * sizeof(float));
+        out.write((const char*)layer.bias.data(), layer.bias.size() * sizeof(float));
+    }
+    return true;
+}
+
+bool LoadMlp(const char* path, Mlp& mlp) {
+    std::ifstream in(path, std::ios::binary);
+    unsigned int header[3];
+    if (!in.is_open() || !in.read((char*)header, sizeof(header)) || header[0] != mlpMagic || header[1] != mlpVersion) {
+        std::cout << "[Mlp] " << path << " isn't a network" << std::endl;
+        return false;
+    }
+
+    mlp.layers.clear();
+    mlp.useQuantized = false;
+    for (unsigned int l = 0; l < header[2]; l++) {
+        unsigned int sizes[3];
+        if (!in.read((char*)sizes, sizeof(sizes))) {
+            std::cout << "[Mlp] " << path << " is cut short" << std::endl;
+            return false;
+        }
+
+        bool fits = l == 0 || sizes[0] == mlp.layers.back().outputs;
+        if (!fits || sizes[0] == 0 || sizes[1] == 0 || sizes[0] > maxLayerSize || sizes[1] > maxLayerSize || sizes[2] > MLP_TANH) {
+            std::cout << "[Mlp] " << path << " has a bad layer " << l << std::endl;
+            return false;
+        }
+
+        MlpLayer layer;
+        layer.inputs = sizes[0];
+        layer.outputs = sizes[1];
+        layer.activation = (MlpActivation)sizes[2];
+        layer.weights.resize((size_t)layer.inputs * layer.outputs);
+        layer.bias.resize(layer.outputs);
+        if (!in.read((char*)layer.weights.data(), layer.weights.size() * sizeof(float))
+            || !in.read((char*)layer.bias.data(), layer.bias.size() * sizeof(float))) {
+            std::cout << "[Mlp] " << path << " is cut short" << std::endl;
+            return false;
+        }
+        mlp.layers.push_back(layer);
+    }
+    return true;
+}
+
+void QuantizeMlp(Mlp& mlp) {
+    for (MlpLayer& layer : mlp.layers) {
+        const size_t inputs = layer.inputs;
+        const size_t outputs = layer.outputs;
+        layer.quantized.resize(inputs * outputs);
+        layer.scales.resize(outputs);
+
+        // symmetric per output, the largest weight in a column maps to 127
+        for (size_t j = 0; j < outputs; j++) {
+            float largest = 0.0f;
+            for (size_t p = 0; p < inputs; p++)
+                largest = std::max(largest, std::fabs(layer.weights[p * outputs + j]));
+
+            float scale = largest > 0.0f ? largest / 127.0f : 1.0f;
+            layer.scales[j] = scale;
+            for (size_t p = 0; p < inputs; p++)
+                layer.quantized[p * outputs + j] = (int8_t)std::lround(layer.weights[p * outputs + j] / scale);
+        }
+    }
+    mlp.useQuantized = true;
+}
+
+// the matrix multiplies below all do c (rows by n) += a (rows by k) times b (k by n), everything row major
+// they work through k and the rows in blocks so a block of a and the part of b it needs stay in cache
+const size_t gemmDepth = 256;
+const size_t gemmRows = 64;
+
+template <typename Weight>
+static void GemmScalar(const float* a, const Weight* b, float* c, size_t rows, size_t k, size_t n) {
+    for (size_t p0 = 0; p0 < k; p0 += gemmDepth) {
+        const size_t p1 = std::min(p0 + gemmDepth, k);
+        for (size_t i = 0; i < rows; i++) {
+            float* row = c + i * n;
+            for (size_t p = p0; p < p1; p++) {
+                const float x = a[i * k + p];
+                const Weight* weights = b + p * n;
+                for (size_t j = 0; j < n; j++)
+                    row[j] += x * (float)weights[j];
+            }
+        }
+    }
+}
+
+#ifdef CPU_X86
+
+CPU_TARGET("avx2,fma")
+static inline __m256 LoadWeights(const float* weights) {
+    return _mm256_loadu_ps(weights);
+}
+
+// int8 weights get widened to floats as they're loaded, the column scales are applied once at the end
+CPU_TARGET("avx2,fma")
+static inline __m256 LoadWeights(const int8_t* weights) {
+    return _mm256_cvtepi32_ps(_mm256_cvtepi8_epi32(_mm_loadl_epi64((const __m128i*)weights)));
+}
+
+// 4 rows by 16 columns of c live in registers while a block of k goes by
+template <typename Weight>
+CPU_TARGET("avx2,fma")
+static void GemmAvx2(const float* a, const Weight* b, float* c, size_t rows, size_t k, size_t n) {
+    for (size_t p0 = 0; p0 < k; p0 += gemmDepth) {
+        const size_t p1 = std::min(p0 + gemmDepth, k);
+        for (size_t i0 = 0; i0 < rows; i0 += gemmRows) {
+            const size_t i1 = std::min(i0 + gemmRows, rows);
+            size_t i = i0;
+            for (; i + 4 <= i1; i += 4) {
+                const float* a0 = a + i * k;
+                const float* a1 = a0 + k;
+                const float* a2 = a1 + k;
+                const float* a3 = a2 + k;
+                float* c0 = c + i * n;
+                float* c1 = c0 + n;
+                float* c2 = c1 + n;
+                float* c3 = c2 + n;
+
+                size_t j = 0;
+                for (; j + 16 <= n; j += 16) {
+                    __m256 c00 = _mm256_loadu_ps(c0 + j), c01 = _mm256_loadu_ps(c0 + j + 8);
+                    __m256 c10 = _mm256_loadu_ps(c1 + j), c11 = _mm256_loadu_ps(c1 + j + 8);
+                    __m256 c20 = _mm256_loadu_ps(c2 + j), c21 = _mm256_loadu_ps(c2 + j + 8);
+                    __m256 c30 = _mm256_loadu_ps(c3 + j), c31 = _mm256_loadu_ps(c3 + j + 8);
+                    for (size_t p = p0; p < p1; p++) {
+                        __m256 b0 = LoadWeights(b + p * n + j);
+                        __m256 b1 = LoadWeights(b + p * n + j + 8);
+                        __m256 x = _mm256_broadcast_ss(a0 + p);
+                        c00 = _mm256_fmadd_ps(x, b0, c00);
+                        c01 = _mm256_fmadd_ps(x, b1, c01);
+                        x = _mm256_broadcast_ss(a1 + p);
+                        c10 = _mm256_fmadd_ps(x, b0, c10);
+                        c11 = _mm256_fmadd_ps(x, b1, c11);
+                        x = _mm256_broadcast_ss(a2 + p);
+                        c20 = _mm256_fmadd_ps(x, b0, c20);
+                        c21 = _mm256_fmadd_ps(x, b1, c21);
+                        x = _mm256_broadcast_ss(a3 + p);
+                        c30 = _mm256_fmadd_ps(x, b0, c30);
+                        c31 = _mm256_fmadd_ps(x, b1, c31);
+                    }
+                    _mm256_storeu_ps(c0 + j, c00);
+                    _mm256_storeu_ps(c0 + j + 8, c01);
+                    _mm256_storeu_ps(c1 + j, c10);
+                    _mm256_storeu_ps(c1 + j + 8, c11);
+                    _mm256_storeu_ps(c2 + j, c20);
+                    _mm256_storeu_ps(c2 + j + 8, c21);
+                    _mm256_storeu_ps(c3 + j, c30);
+                    _mm256_storeu_ps(c3 + j + 8, c31);
+                }
+                for (; j + 8 <= n; j += 8) {
+                    __m256 c00 = _mm256_loadu_ps(c0 + j);
+                    __m256 c10 = _mm256_loadu_ps(c1 + j);
+                    __m256 c20 = _mm256_loadu_ps(c2 + j);
+                    __m256 c30 = _mm256_loadu_ps(c3 + j);
+                    for (size_t p = p0; p < p1; p++) {
+                        __m256 b0 = LoadWeights(b + p * n + j);
+                        c00 = _mm256_fmadd_ps(_mm256_broadcast_ss(a0 + p), b0, c00);
+                        c10 = _mm256_fmadd_ps(_mm256_broadcast_ss(a1 + p), b0, c10);
+                        c20 = _mm256_fmadd_ps(_mm256_broadcast_ss(a2 + p), b0, c20);
+                        c30 = _mm256_fmadd_ps(_mm256_broadcast_ss(a3 + p), b0, c30);
+                    }
+                    _mm256_storeu_ps(c0 + j, c00);
+                    _mm256_storeu_ps(c1 + j, c10);
+                    _mm256_storeu_ps(c2 + j, c20);
+                    _mm256_storeu_ps(c3 + j, c30);
+                }
+                // narrow output layers end up here, a policy usually has just the one output
+                for (; j < n; j++) {
+                    float s0 = c0[j], s1 = c1[j], s2 = c2[j], s3 = c3[j];
+                    for (size_t p = p0; p < p1; p++) {
+                        float weight = (float)b[p * n + j];
+                        s0 += a0[p] * weight;
+                        s1 += a1[p] * weight;
+                        s2 += a2[p] * weight;
+                        s3 += a3[p] * weight;
+                    }
+                    c0[j] = s0;
+                    c1[j] = s1;
+                    c2[j] = s2;
+                    c3[j] = s3;
+                }
+            }
+
+            // leftover rows at the end of the batch
+            for (; i < i1; i++) {
+                float* row = c + i * n;
+                for (size_t p = p0; p < p1; p++) {
+                    const float x = a[i * k + p];
+                    for (size_t j = 0; j < n; j++)
+                        row[j] += x * (float)b[p * n + j];
+                }
+            }
+        }
+    }
+}
+
+#endif
+
+static MlpKernel activeKernel = BestMlpKernel();
+
+MlpKernel BestMlpKernel() {
+    return Cpu().avx2 && Cpu().fma ? MLP_AVX2 : MLP_SCALAR;
+}
+
+void UseMlpKernel(MlpKernel kernel) {
+    activeKernel = kernel <= BestMlpKernel() ? kernel : BestMlpKernel();
+}
+
+MlpKernel ActiveMlpKernel() {
+    return activeKernel;
+}
+
+template <typename Weight>
+static void Gemm(const float* a, const Weight* b, float* c, size_t rows, size_t k, size_t n) {
+#ifdef CPU_X86
+    if (activeKernel == MLP_AVX2) {
+        GemmAvx2(a, b, c, rows, k, n);
+        return;
+    }
+#endif
+    GemmScalar(a, b, c, rows, k, n);
+}
+
+// scales, bias and activation for a layer's outputs
+// relu's sign is a coin flip for a fresh network, a compare would become a branch the cpu keeps mispredicting
+// so it's (x + |x|) / 2 instead, which is exactly max(x, 0)
+static void FinishScalar(const MlpLayer& layer, bool quantized, float* out, size_t rows) {
+    const size_t n = layer.outputs;
+    const float* bias = layer.bias.data();
+    const float* scales = layer.scales.data();
+    for (size_t i = 0; i < rows; i++) {
+        float* row = out + i * n;
+        for (size_t j = 0; j < n; j++) {
+            float x = quantized ? row[j] * scales[j] + bias[j] : row[j] + bias[j];
+            if (layer.activation == MLP_RELU)
+                x = (x + std::fabs(x)) * 0.5f;
+            row[j] = x;
+        }
+    }
+}
+
+#ifdef CPU_X86
+
+// the same thing 8 columns at a time, no fused multiply add so it matches the scalar version exactly
+// the leftover columns use single lane intrinsics too, with fma enabled the compiler would otherwise fuse row[j] * scales[j] + bias[j]
+CPU_TARGET("avx2,fma")
+static void FinishAvx2(const MlpLayer& layer, bool quantized, float* out, size_t rows) {
+    const size_t n = layer.outputs;
+    const float* bias = layer.bias.data();
+    const float* scales = layer.scales.data();
+    const bool relu = layer.activation == MLP_RELU;
+    const __m256 zero = _mm256_setzero_ps();
+    for (size_t i = 0; i < rows; i++) {
+        float* row = out + i * n;
+        size_t j = 0;
+        for (; j + 8 <= n; j += 8) {
+            __m256 x = _mm256_loadu_ps(row + j);
+            if (quantized)
+                x = _mm256_mul_ps(x, _mm256_loadu_ps(scales + j));
+            x = _mm256_add_ps(x, _mm256_loadu_ps(bias + j));
+            if (relu)
+                x = _mm256_max_ps(x, zero);
+            _mm256_storeu_ps(row + j, x);
+        }
+        for (; j < n; j++) {
+            __m128 x = _mm_set_ss(row[j]);
+            if (quantized)
+                x = _mm_mul_ss(x, _mm_set_ss(scales[j]));
+            x = _mm_add_ss(x, _mm_set_ss(bias[j]));
+            if (relu)
+                x = _mm_max_ss(x, _mm_setzero_ps());
+            row[j] = _mm_cvtss_f32(x);
+        }
+    }
+}
+
+#endif
+
+static void FinishLayer(const MlpLayer& layer, bool quantized, float* out, size_t rows) {
+#ifdef CPU_X86
+    if (activeKernel == MLP_AVX2)
+        FinishAvx2(layer, quantized, out, rows);
+    else
+#endif
+        FinishScalar(layer, quantized, out, rows);
+
+    if (layer.activation == MLP_TANH) {
+        for (size_t i = 0; i < rows * layer.outputs; i++)
+            out[i] = std::tanh(out[i]);
+    }
+}
+
+void RunMlp(const Mlp& mlp, const float* inputs, size_t rows, float* outputs, MlpScratch& scratch) {
+    const float* in = inputs;
+    for (size_t l = 0; l < mlp.layers.size(); l++) {
+        const MlpLayer& layer = mlp.layers[l];
+
+        // hidden layers ping pong between the two scratch buffers, the last one writes straight out
+        float* out = outputs;
+        if (l + 1 < mlp.layers.size()) {
+            std::vector<float>& buffer = l % 2 == 0 ? scratch.front : scratch.back;
+            buffer.resize(rows * layer.outputs);
+            out = buffer.data();
+        }
+        std::fill(out, out + rows * layer.outputs, 0.0f);
+
+        bool quantized = mlp.useQuantized && !layer.quantized.empty();
+        if (quantized)
+            Gemm(in, layer.quantized.data(), out, rows, layer.inputs, layer.outputs);
+        else
+            Gemm(in, layer.weights.data(), out, rows, layer.inputs, layer.outputs);
+        FinishLayer(layer, quantized, out, rows);
+
+        in = out;
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+// small fully connected networks for paddle policies, run on a whole batch of observations at once
+// each layer is one matrix multiply of the batch's activations (a row per observation) by the layer's weights
+
+enum MlpActivation {
+    MLP_LINEAR,
+    MLP_RELU,
+    MLP_TANH
+};
+
+struct MlpLayer {
+    unsigned int inputs;
+    unsigned int outputs;
+    MlpActivation activation;
+    std::vector<float> weights; // a row of outputs for every input
+    std::vector<float> bias;
+
+    // filled in by QuantizeMlp, each output's column of weights as int8 times that column's scale
+    std::vector<int8_t> quantized;
+    std::vector<float> scales;
+};
+
+struct Mlp {
+    std::vector<MlpLayer> layers;
+    bool useQuantized = false;
+};
+
+// sizes go from the input layer to the output, hidden layers get relu and the last one tanh
+// weights start out small and random, scaled by each layer's size so activations neither blow up nor die out
+void InitMlp(Mlp& mlp, const std::vector<unsigned int>& sizes, unsigned int seed);
+
+unsigned int MlpInputs(const Mlp& mlp);
+unsigned int MlpOutputs(const Mlp& mlp);
+
+// flat little endian file: a header, then every layer's size, weights and bias as floats
+bool SaveMlp(const char* path, const Mlp& mlp);
+bool LoadMlp(const char* path, Mlp& mlp);
+
+// makes RunMlp use int8 weights, a quarter of the memory at a small cost in accuracy
+// call it again after changing the float weights
+void QuantizeMlp(Mlp& mlp);
+
+// which matrix multiply RunMlp uses, the avx2 one fuses its multiplies and adds so the results can differ
+// from the scalar one in the last bits
+enum MlpKernel {
+    MLP_SCALAR,
+    MLP_AVX2
+};
+
+MlpKernel BestMlpKernel();
+void UseMlpKernel(MlpKernel kernel);
+MlpKernel ActiveMlpKernel();
+
+// activations between layers, kept around so running a batch doesn't allocate
+struct MlpScratch {
+    std::vector<float> front;
+    std::vector<float> back;
+};
+
+// inputs has MlpInputs floats per row and outputs gets MlpOutputs floats per row
+void RunMlp(const Mlp& mlp, const float* inputs, size_t rows, float* outputs, MlpScratch& scratch);
@@ -0,0 +1,26 @@
+#include "NeuralPolicy.h"
+
+#include <cmath>
+
+#include "Input.h"
+#include "Paddle.h"
+
+void Observe(const MatchState& state, MatchSide side, float* observation) {
+    const float* positions = state.positions;
+    const float mirror = side == SIDE_RIGHT ? 1.0f : -1.0f;
+    const int own = side == SIDE_LEFT ? 1 : 25;
+    const int other = side == SIDE_LEFT ? 25 : 1;
+
+    // the ball's first and fifth vertices are on opposite sides of its centre
+    observation[0] = (positions[8] + positions[16]) / 2 * mirror;
+    observation[1] = (positions[9] + positions[17]) / 2;
+    observation[2] = std::cos(state.ballAngle) * state.ballSpeed * 100.0f * mirror;
+    observation[3] = std::sin(state.ballAngle) * state.ballSpeed * 100.0f;
+    observation[4] = (positions[own] + positions[own + 4]) / 2;
+    observation[5] = (positions[other] + positions[other + 4]) / 2;
+    observation[6] = state.timer > 100 ? 0.0f : 1.0f;
+}
+
+float NeuralVert(float output) {
+    return ClampFloat(output, -1.0f, 1.0f) * paddleStep;
+}
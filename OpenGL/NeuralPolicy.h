@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "Match.h"
+#include "Policies.h"
+#include "Mlp.h"
+
+// paddle controllers driven by an Mlp
+// a network is never run for one match at a time, DecideNeural gathers every running match in a batch into one
+// matrix, runs the network once and hands each NeuralPolicy its move before the batch ticks
+
+const unsigned int observationCount = 7;
+
+// what a network sees of a match, mirrored for the left side so one network can play either paddle
+// 0 ball x (own paddle at +0.97), 1 ball y, 2 and 3 ball velocity scaled to about one, 4 own paddle y,
+// 5 other paddle y, 6 one while the ball waits to be served
+void Observe(const MatchState& state, MatchSide side, float* observation);
+
+// a network's output in -1 to 1 as a move, the same top speed as a held key
+float NeuralVert(float output);
+
+// moves by whatever DecideNeural set, like HumanPolicy
+struct NeuralPolicy {
+    float vert = 0.0f;
+
+    void Move(MatchState& state, MatchSide side) {
+        MovePaddle(state, side, vert);
+    }
+};
+
+// reused between ticks so a batch doesn't allocate
+struct NeuralBatch {
+    std::vector<float> observations;
+    std::vector<float> outputs;
+    std::vector<size_t> running;
+    MlpScratch scratch;
+};
+
+// runs mlp for every match that isn't over and sets the move of the NeuralPolicy policy points to in each
+// e.g. DecideNeural(matches, &Match<NeuralPolicy, TrackingPolicy>::left, SIDE_LEFT, mlp, batch)
+// returns how many matches it ran for
+template <typename MatchType>
+size_t DecideNeural(std::vector<MatchType>& matches, NeuralPolicy MatchType::* policy, MatchSide side, const Mlp& mlp, NeuralBatch& batch) {
+    batch.running.clear();
+    for (size_t i = 0; i < matches.size(); i++) {
+        if (!MatchOver(matches[i].state))
+            batch.running.push_back(i);
+    }
+
+    const size_t rows = batch.running.size();
+    batch.observations.resize(rows * observationCount);
+    batch.outputs.resize(rows * MlpOutputs(mlp));
+    for (size_t r = 0; r < rows; r++)
+        Observe(matches[batch.running[r]].state, side, &batch.observations[r * observationCount]);
+
+    RunMlp(mlp, batch.observations.data(), rows, batch.outputs.data(), batch.scratch);
+
+    for (size_t r = 0; r < rows; r++)
+        (matches[batch.running[r]].*policy).vert = NeuralVert(batch.outputs[r * MlpOutputs(mlp)]);
+    return rows;
+}
@@ -0,0 +1,109 @@
+#include "Offscreen.h"
+
+#include <iostream>
+#include <cstring>
+
+#include "Renderer.h"
+
+OffscreenTarget::OffscreenTarget(int width, int height)
+    : m_Width(width), m_Height(height) {
+    glGenRenderbuffers(1, &m_Color);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_Color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+
+    glGenFramebuffers(1, &m_Framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_Color);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "[Offscreen] framebuffer incomplete" << std::endl;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+OffscreenTarget::~OffscreenTarget() {
+    glDeleteFramebuffers(1, &m_Framebuffer);
+    glDeleteRenderbuffers(1, &m_Color);
+}
+
+void OffscreenTarget::Bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_Framebuffer);
+    glViewport(0, 0, m_Width, m_Height);
+}
+
+void OffscreenTarget::Unbind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+PixelReader::PixelReader(int width, int height, unsigned int depth)
+    : m_Width(width), m_Height(height), m_Buffers(depth), m_Fences(depth, nullptr), m_Next(0), m_Pending(0) {
+    glGenBuffers(depth, m_Buffers.data());
+    for (unsigned int buffer : m_Buffers) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+        glBufferData(GL_PIXEL_PACK_BUFFER, FrameBytes(), nullptr, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+PixelReader::~PixelReader() {
+    for (void* fence : m_Fences) {
+        if (fence)
+            glDeleteSync((GLsync)fence);
+    }
+    glDeleteBuffers((GLsizei)m_Buffers.size(), m_Buffers.data());
+}
+
+bool PixelReader::Request() {
+    if (m_Pending == m_Buffers.size())
+        return false;
+
+    // with a pack buffer bound glReadPixels only queues the copy and returns right away
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Buffers[m_Next]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, m_Width, m_Height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_Fences[m_Next] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_Next = (m_Next + 1) % m_Buffers.size();
+    m_Pending++;
+    return true;
+}
+
+bool PixelReader::Read(unsigned char* pixels, bool wait) {
+    if (m_Pending == 0)
+        return false;
+
+    unsigned int oldest = (unsigned int)((m_Next + m_Buffers.size() - m_Pending) % m_Buffers.size());
+    GLsync fence = (GLsync)m_Fences[oldest];
+
+    // only the first check flushes, after that the copy is already on its way
+    GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait ? GL_TIMEOUT_IGNORED : 0);
+    if (status == GL_TIMEOUT_EXPIRED)
+        return false;
+
+    glDeleteSync(fence);
+    m_Fences[oldest] = nullptr;
+
+    // a frame that can't be read is dropped so its buffer can be used again, the caller never sees its stale contents
+    if (status == GL_WAIT_FAILED) {
+        std::cerr << "[Offscreen] waiting for a frame's copy failed, dropped it" << std::endl;
+        m_Pending--;
+        return false;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, m_Buffers[oldest]);
+    void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, FrameBytes(), GL_MAP_READ_BIT);
+    if (data) {
+        memcpy(pixels, data, FrameBytes());
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_Pending--;
+    if (!data) {
+        std::cerr << "[Offscreen] couldn't map a frame's pixels, dropped it" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+// a framebuffer to draw into instead of the window
+class OffscreenTarget {
+public:
+    OffscreenTarget(int width, int height);
+    ~OffscreenTarget();
+
+    // draws go here and the viewport is set to the target's size
+    void Bind() const;
+    void Unbind() const;
+
+    int Width() const { return m_Width; }
+    int Height() const { return m_Height; }
+
+private:
+    int m_Width;
+    int m_Height;
+    unsigned int m_Framebuffer;
+    unsigned int m_Color;
+};
+
+// reads frames back through a ring of pixel pack buffers so glReadPixels never waits on the gpu
+// a frame comes out Depth - 1 frames after it was requested, rows bottom to top in rgba
+class PixelReader {
+public:
+    PixelReader(int width, int height, unsigned int depth = 3);
+    ~PixelReader();
+
+    // starts copying the bound framebuffer, returns false if every buffer is still waiting to be read
+    bool Request();
+
+    // copies the oldest finished frame into pixels, returns false if the gpu isn't done with it yet
+    // with wait set it blocks instead, used to drain the ring at the end
+    // also false when the wait or the map fails, that frame is dropped and pixels is left alone
+    bool Read(unsigned char* pixels, bool wait = false);
+
+    unsigned int Pending() const { return m_Pending; }
+    size_t FrameBytes() const { return (size_t)m_Width * m_Height * 4; }
+
+private:
+    int m_Width;
+    int m_Height;
+    std::vector<unsigned int> m_Buffers;
+    std::vector<void*> m_Fences; // GLsync, kept as void* so this header doesn't need glew
+    unsigned int m_Next; // buffer the next request goes into
+    unsigned int m_Pending; // requested but not read yet
+};
@@ -0,0 +1,19 @@
+#include "Paddle.h"
+
+PaddleController MakePaddleController(float low, float high, float maxSpeed, float maxAccel) {
+    PaddleController controller;
+    controller.limits = { low, high, maxSpeed, maxAccel };
+    controller.velocity = 0.0f;
+    return controller;
+}
+
+float StepPaddle(PaddleController& controller, float bottom, float top, float want) {
+    const PaddleLimits& limits = controller.limits;
+
+    float move = ClampFloat(want, -limits.maxSpeed, limits.maxSpeed);
+    move = ClampFloat(move, controller.velocity - limits.maxAccel, controller.velocity + limits.maxAccel);
+    move += PaddleCorrection(bottom + move, top + move, limits.low, limits.high);
+
+    controller.velocity = move;
+    return move;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cmath>
+
+// paddle movement shared by every mode, all of it constant time no matter how far a paddle is asked to move
+// the clamps are written as min and max so they compile to minss/maxss instead of branches
+
+inline float ClampFloat(float value, float low, float high) {
+    float raised = value < low ? low : value;
+    return raised > high ? high : raised;
+}
+
+// how far a paddle spanning bottom to top has to move to fit between low and high
+inline float PaddleCorrection(float bottom, float top, float low, float high) {
+    float under = low - bottom;
+    float over = top - high;
+    return (under > 0.0f ? under : 0.0f) - (over > 0.0f ? over : 0.0f);
+}
+
+// same, but backing off in whole steps like the classic match's clamp loops did
+// a paddle that pokes out by less than a step ends up a little inside the edge instead of on it
+inline float SnappedCorrection(float bottom, float top, float low, float high, float step) {
+    float under = low - bottom;
+    float over = top - high;
+    float up = std::ceil((under > 0.0f ? under : 0.0f) / step);
+    float down = std::ceil((over > 0.0f ? over : 0.0f) / step);
+    return (up - down) * step;
+}
+
+const float noAccelLimit = 1e30f;
+
+struct PaddleLimits {
+    float low; // lowest the bottom edge can go
+    float high; // highest the top edge can go
+    float maxSpeed; // per tick
+    float maxAccel; // change in speed per tick, noAccelLimit for instant response
+};
+
+struct PaddleController {
+    PaddleLimits limits;
+    float velocity; // what the paddle moved last tick
+};
+
+PaddleController MakePaddleController(float low, float high, float maxSpeed, float maxAccel = noAccelLimit);
+
+// how far to move a paddle spanning bottom to top this tick when it wants to move by want
+// running into an edge stops it, so it has to speed up again from there
+float StepPaddle(PaddleController& controller, float bottom, float top, float want);
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#include "Match.h"
+
+// paddle controllers for Match, each one a plain struct with
+//     void Move(MatchState& state, MatchSide side)
+// that moves its own paddle for one tick, the match keeps it on screen afterwards
+// they're template parameters instead of virtual classes so every pairing gets its own tick with both controllers inlined
+
+// moves by whatever vert was set to before the tick, like the vert passed to TickMatch
+struct HumanPolicy {
+    float vert = 0.0f;
+
+    void Move(MatchState& state, MatchSide side) {
+        MovePaddle(state, side, vert);
+    }
+};
+
+// the classic bot
+struct TrackingPolicy {
+    void Move(MatchState& state, MatchSide side) {
+        TrackStep(state, side);
+    }
+};
+
+// the y the ball will be at when its centre reaches x, going from (ballX, ballY) at velocity (vx, vy)
+// bounces off the top and bottom included
+inline float CrossingY(float ballX, float ballY, float vx, float vy, float x, float ballSize) {
+    // unfold the bounces, the ball travels a 4 unit tall loop between the walls (less its own height)
+    const float reach = 1.0f - ballSize * 16.0f / 9;
+    float y = ballY + vy * ((x - ballX) / vx) + reach;
+    float period = 4.0f * reach;
+    y -= std::floor(y / period) * period;
+    return (y < 2.0f * reach ? y : 4.0f * reach - y) - reach;
+}
+
+// works out where the ball will cross the paddle and heads there
+// waits in the middle while the ball is going the other way
+struct PredictivePolicy {
+    void Move(MatchState& state, MatchSide side) {
+        const float* positions = state.positions;
+        const int first = side == SIDE_LEFT ? 1 : 25;
+        const float paddleX = side == SIDE_LEFT ? positions[2] : positions[26]; // the inner edge
+
+        // the ball's first and fifth vertices are on opposite sides of its centre
+        float ballX = (positions[8] + positions[16]) / 2;
+        float ballY = (positions[9] + positions[17]) / 2;
+        float vx = std::cos(state.ballAngle);
+        float vy = std::sin(state.ballAngle);
+
+        float target = 0.0f;
+        bool coming = side == SIDE_LEFT ? vx < 0.0f : vx > 0.0f;
+        if (coming && state.timer > 100)
+            target = CrossingY(ballX, ballY, vx, vy, paddleX, state.rules.ballSize);
+
+        // same 0.01 steps as the tracking bot, and a dead zone so it doesn't wobble around the target
+        float centre = (positions[first] + positions[first + 4]) / 2;
+        float step = target > centre + 0.005f ? 0.01f : (target < centre - 0.005f ? -0.01f : 0.0f);
+        MovePaddle(state, side, step);
+    }
+};
+
+// TrackStep with its constants pulled out so they can be tuned, the defaults play exactly like TrackingPolicy
+struct BotParams {
+    float step = 0.01f; // how far it moves a tick
+    float engageX = 0.0f; // starts following once the ball's leading vertex is this far onto its own half (the middle is 0)
+    float deadZone = 0.0f; // stays put while the paddle's centre is within this of the target
+    float lead = 0.0f; // 0 follows the ball's height, 1 heads for where it will cross the paddle
+    float recenter = 0.0f; // how fast it drifts back to the middle while the ball is going the other way
+};
+
+struct TunedPolicy {
+    BotParams params;
+
+    void Move(MatchState& state, MatchSide side) {
+        float* positions = state.positions;
+        const float ballAngle = state.ballAngle;
+        const int first = side == SIDE_LEFT ? 1 : 25;
+        const float mirror = side == SIDE_RIGHT ? 1.0f : -1.0f;
+
+        bool headingRight = (ballAngle < (pi / 2)) || (ballAngle > (3 * pi / 2));
+        bool coming = positions[8] * mirror > params.engageX && (side == SIDE_RIGHT ? headingRight : !headingRight);
+
+        if (!coming) {
+            float centre = (positions[first] + positions[first + 4]) / 2;
+            if (centre > params.recenter)
+                MovePaddle(state, side, -params.recenter);
+            else if (centre < -params.recenter)
+                MovePaddle(state, side, params.recenter);
+            return;
+        }
+
+        float target = positions[9];
+        if (params.lead != 0.0f) {
+            const float paddleX = side == SIDE_LEFT ? positions[2] : positions[26];
+            float ballX = (positions[8] + positions[16]) / 2;
+            float ballY = (positions[9] + positions[17]) / 2;
+            float crossing = CrossingY(ballX, ballY, std::cos(ballAngle), std::sin(ballAngle), paddleX, state.rules.ballSize);
+            target += params.lead * (crossing - target);
+        }
+
+        // two checks like TrackStep, the second sees where the first one left the paddle
+        if ((positions[first] + positions[first + 4]) / 2 > target + params.deadZone)
+            MovePaddle(state, side, -params.step);
+        if ((positions[first] + positions[first + 4]) / 2 < target - params.deadZone)
+            MovePaddle(state, side, params.step);
+    }
+};
+
+// plays back recorded moves, like a Replay's inputs, then stands still
+struct ScriptedPolicy {
+    const float* moves = nullptr;
+    size_t count = 0;
+    size_t next = 0;
+
+    void Move(MatchState& state, MatchSide side) {
+        MovePaddle(state, side, next < count ? moves[next++] : 0.0f);
+    }
+};
+
+template <typename LeftPolicy, typename RightPolicy>
+struct Match {
+    MatchState state;
+    LeftPolicy left;
+    RightPolicy right;
+};
+
+// Match<HumanPolicy, TrackingPolicy> ticks exactly like TickMatch
+typedef Match<HumanPolicy, TrackingPolicy> ClassicMatch;
+
+template <typename LeftPolicy, typename RightPolicy>
+inline void TickMatch(Match<LeftPolicy, RightPolicy>& match) {
+    match.left.Move(match.state, SIDE_LEFT);
+    ClampPaddle(match.state, SIDE_LEFT);
+    match.right.Move(match.state, SIDE_RIGHT);
+    ClampPaddle(match.state, SIDE_RIGHT);
+    TickBall(match.state);
+}
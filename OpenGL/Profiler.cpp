@@ -0,0 +1,210 @@
+#include "Profiler.h"
+
+#ifdef PROFILING
+
+#include <GL/glew.h>
+
+#include <iostream>
+#include <fstream>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <string>
+
+#include "Timing.h"
+
+const unsigned int eventCapacity = 1 << 16; // power of two
+const unsigned int queryCapacity = 256; // gpu scopes in flight at once
+const unsigned int gpuThread = 0; // shows up as its own row in the trace
+
+// ring buffer
+
+struct ProfileEvent {
+    std::atomic<unsigned long long> sequence; // index + 1 once written, 0 while being written
+    const char* name;
+    unsigned int thread;
+    double begin;
+    double end;
+};
+
+static ProfileEvent events[eventCapacity];
+static std::atomic<unsigned long long> eventCount(0);
+
+void ProfileRecord(const char* name, unsigned int thread, double begin, double end) {
+    unsigned long long index = eventCount.fetch_add(1, std::memory_order_relaxed);
+    ProfileEvent& event = events[index & (eventCapacity - 1)];
+
+    event.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    event.name = name;
+    event.thread = thread;
+    event.begin = begin;
+    event.end = end;
+    event.sequence.store(index + 1, std::memory_order_release);
+}
+
+// threads
+
+static std::mutex threadMutex;
+static std::vector<std::string> threadNames(1, "gpu");
+
+static unsigned int ThreadId() {
+    thread_local unsigned int id = 0;
+    if (id == 0) {
+        std::lock_guard<std::mutex> lock(threadMutex);
+        id = (unsigned int)threadNames.size();
+        threadNames.push_back("thread " + std::to_string(id));
+    }
+    return id;
+}
+
+void ProfileThreadName(const char* name) {
+    unsigned int id = ThreadId();
+    std::lock_guard<std::mutex> lock(threadMutex);
+    threadNames[id] = name;
+}
+
+CpuProfileScope::CpuProfileScope(const char* name)
+    : m_Name(name), m_Begin(Now()) {}
+
+CpuProfileScope::~CpuProfileScope() {
+    ProfileRecord(m_Name, ThreadId(), m_Begin, Now());
+}
+
+// gpu queries, everything here runs on the gl thread
+
+struct GpuQuery {
+    const char* name;
+    unsigned int begin;
+    unsigned int end;
+    bool pending;
+};
+
+static GpuQuery queries[queryCapacity];
+static bool queriesCreated = false;
+static double gpuOffset = 0.0; // add to a gpu timestamp in seconds to get Now()
+
+static void CreateQueries() {
+    for (unsigned int i = 0; i < queryCapacity; i++) {
+        glGenQueries(1, &queries[i].begin);
+        glGenQueries(1, &queries[i].end);
+        queries[i].pending = false;
+    }
+
+    // line the gpu clock up with the cpu one
+    GLint64 gpuNow;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    gpuOffset = Now() - gpuNow * 1e-9;
+
+    queriesCreated = true;
+}
+
+GpuProfileScope::GpuProfileScope(const char* name)
+    : m_Slot(-1) {
+    if (!queriesCreated)
+        CreateQueries();
+
+    for (unsigned int i = 0; i < queryCapacity; i++) {
+        if (!queries[i].pending) {
+            m_Slot = (int)i;
+            break;
+        }
+    }
+    if (m_Slot == -1)
+        return;
+
+    queries[m_Slot].name = name;
+    queries[m_Slot].pending = true;
+    glQueryCounter(queries[m_Slot].begin, GL_TIMESTAMP);
+}
+
+GpuProfileScope::~GpuProfileScope() {
+    if (m_Slot != -1)
+        glQueryCounter(queries[m_Slot].end, GL_TIMESTAMP);
+}
+
+void ProfileCollectGpu() {
+    if (!queriesCreated)
+        return;
+
+    for (unsigned int i = 0; i < queryCapacity; i++) {
+        GpuQuery& query = queries[i];
+        if (!query.pending)
+            continue;
+
+        // the end query finishes last so checking it is enough
+        GLint available = 0;
+        glGetQueryObjectiv(query.end, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+
+        GLuint64 begin, end;
+        glGetQueryObjectui64v(query.begin, GL_QUERY_RESULT, &begin);
+        glGetQueryObjectui64v(query.end, GL_QUERY_RESULT, &end);
+        ProfileRecord(query.name, gpuThread, begin * 1e-9 + gpuOffset, end * 1e-9 + gpuOffset);
+        query.pending = false;
+    }
+}
+
+// export
+
+static void WriteJsonString(std::ofstream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            out << '\\';
+        out << *c;
+    }
+    out << '"';
+}
+
+void ProfileExportChromeTrace(const char* path) {
+    std::ofstream out(path);
+    if (!out.is_open()) {
+        std::cout << "[Profiler] couldn't open " << path << std::endl;
+        return;
+    }
+
+    out << "{\"traceEvents\":[\n";
+
+    bool first = true;
+    {
+        std::lock_guard<std::mutex> lock(threadMutex);
+        for (unsigned int i = 0; i < threadNames.size(); i++) {
+            out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i << ",\"args\":{\"name\":";
+            WriteJsonString(out, threadNames[i].c_str());
+            out << "}}";
+            first = false;
+        }
+    }
+
+    unsigned long long count = eventCount.load(std::memory_order_acquire);
+    unsigned long long oldest = count > eventCapacity ? count - eventCapacity : 0;
+    unsigned int written = 0;
+
+    for (unsigned long long index = oldest; index < count; index++) {
+        ProfileEvent& event = events[index & (eventCapacity - 1)];
+
+        // skip slots another thread is in the middle of writing or has already reused
+        if (event.sequence.load(std::memory_order_acquire) != index + 1)
+            continue;
+        const char* name = event.name;
+        unsigned int thread = event.thread;
+        double begin = event.begin;
+        double end = event.end;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (event.sequence.load(std::memory_order_relaxed) != index + 1)
+            continue;
+
+        out << ",\n{\"name\":";
+        WriteJsonString(out, name);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread
+            << ",\"ts\":" << (long long)(begin * 1e6) << ",\"dur\":" << (long long)((end - begin) * 1e6) << "}";
+        written++;
+    }
+
+    out << "\n]}\n";
+    std::cout << "[Profiler] wrote " << written << " events to " << path << std::endl;
+}
+
+#endif
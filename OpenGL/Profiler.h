@@ -0,0 +1,57 @@
+#pragma once
+
+// scoped cpu and gpu timing markers, only compiled in when PROFILING is defined
+// PROFILE_SCOPE("name") times the rest of the enclosing block on the calling thread
+// PROFILE_GPU_SCOPE("name") does the same on the gpu with timestamp queries, only use it on the gl thread
+// names have to be string literals since only the pointer is kept
+
+#ifdef PROFILING
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#define PROFILE_SCOPE(name) CpuProfileScope PROFILE_CONCAT(cpuProfileScope, __LINE__)(name)
+#define PROFILE_GPU_SCOPE(name) GpuProfileScope PROFILE_CONCAT(gpuProfileScope, __LINE__)(name)
+#define PROFILE_THREAD(name) ProfileThreadName(name)
+#define PROFILE_FRAME() ProfileCollectGpu()
+#define PROFILE_EXPORT(path) ProfileExportChromeTrace(path)
+
+void ProfileThreadName(const char* name);
+
+// records a finished cpu or gpu event into the ring buffer
+void ProfileRecord(const char* name, unsigned int thread, double begin, double end);
+
+// checks which gpu queries have finished without waiting on any, call once per frame on the gl thread
+void ProfileCollectGpu();
+
+// writes everything still in the ring buffer as a chrome://tracing json file
+void ProfileExportChromeTrace(const char* path);
+
+class CpuProfileScope {
+public:
+    explicit CpuProfileScope(const char* name);
+    ~CpuProfileScope();
+
+private:
+    const char* m_Name;
+    double m_Begin;
+};
+
+class GpuProfileScope {
+public:
+    explicit GpuProfileScope(const char* name);
+    ~GpuProfileScope();
+
+private:
+    int m_Slot; // -1 if every query was still in flight
+};
+
+#else
+
+#define PROFILE_SCOPE(name)
+#define PROFILE_GPU_SCOPE(name)
+#define PROFILE_THREAD(name)
+#define PROFILE_FRAME()
+#define PROFILE_EXPORT(path)
+
+#endif
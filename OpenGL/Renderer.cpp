@@ -0,0 +1,117 @@
+#include "Renderer.h"
+
+#include <iostream>
+#include <algorithm>
+
+void GLClearError() {
+    while (glGetError() != GL_NO_ERROR);
+}
+
+bool GLLogCall(const char* function, const char* file, int line) {
+    while (GLenum error = glGetError()) {
+        std::cout << "[OpenGL Error] (" << error << "):" << function << " " << file << ":" << line << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void CommandBuffer::Draw(unsigned int layer, unsigned int program, const Mesh& mesh,
+    unsigned char r, unsigned char g, unsigned char b, float offsetX, float offsetY) {
+    DrawCommand command;
+    // gl names are small counters so 16 bits each is plenty
+    command.key = ((unsigned long long)(layer & 0xffff) << 48) | ((unsigned long long)(program & 0xffff) << 32)
+        | ((unsigned long long)(mesh.vertexBuffer & 0xffff) << 16) | (mesh.indexBuffer & 0xffff);
+    command.program = program;
+    command.mesh = mesh;
+    command.color[0] = r;
+    command.color[1] = g;
+    command.color[2] = b;
+    command.offset[0] = offsetX;
+    command.offset[1] = offsetY;
+    m_Commands.push_back(command);
+}
+
+Renderer::Renderer()
+    : m_DrawCalls(0), m_StateChanges(0) {}
+
+void Renderer::ResetStats() {
+    m_DrawCalls = 0;
+    m_StateChanges = 0;
+}
+
+const Renderer::ProgramUniforms& Renderer::Uniforms(unsigned int program) {
+    for (const ProgramUniforms& uniforms : m_Uniforms) {
+        if (uniforms.program == program)
+            return uniforms;
+    }
+    ProgramUniforms uniforms = { program, glGetUniformLocation(program, "u_Color"), glGetUniformLocation(program, "u_Offset") };
+    m_Uniforms.push_back(uniforms);
+    return m_Uniforms.back();
+}
+
+void Renderer::Submit(CommandBuffer& commands) {
+    // stable so draws with the same key keep the order they were recorded in
+    m_Sorted = commands.Commands();
+    std::stable_sort(m_Sorted.begin(), m_Sorted.end(), [](const DrawCommand& a, const DrawCommand& b) {
+        return a.key < b.key;
+    });
+    commands.Clear();
+
+    const ProgramUniforms* uniforms = nullptr;
+    unsigned int program = 0, vertexBuffer = 0, indexBuffer = 0;
+    bool haveProgram = false, haveVertices = false, haveIndices = false, haveColor = false, haveOffset = false;
+    unsigned char color[3] = { 0, 0, 0 };
+    float offset[2] = { 0.0f, 0.0f };
+
+    for (const DrawCommand& command : m_Sorted) {
+        if (!haveProgram || command.program != program) {
+            program = command.program;
+            glUseProgram(program);
+            uniforms = &Uniforms(program);
+            haveProgram = true;
+            haveColor = false; // uniforms belong to the program
+            haveOffset = false;
+            m_StateChanges++;
+        }
+
+        if (!haveVertices || command.mesh.vertexBuffer != vertexBuffer) {
+            vertexBuffer = command.mesh.vertexBuffer;
+            glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, 0);
+            haveVertices = true;
+            m_StateChanges++;
+        }
+
+        if (!haveIndices || command.mesh.indexBuffer != indexBuffer) {
+            indexBuffer = command.mesh.indexBuffer;
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+            haveIndices = true;
+            m_StateChanges++;
+        }
+
+        if (!haveColor || command.color[0] != color[0] || command.color[1] != color[1] || command.color[2] != color[2]) {
+            color[0] = command.color[0];
+            color[1] = command.color[1];
+            color[2] = command.color[2];
+            glUniform4f(uniforms->color, color[0] / 255.0f, color[1] / 255.0f, color[2] / 255.0f, 1.0f);
+            haveColor = true;
+            m_StateChanges++;
+        }
+
+        if (!haveOffset || command.offset[0] != offset[0] || command.offset[1] != offset[1]) {
+            offset[0] = command.offset[0];
+            offset[1] = command.offset[1];
+            glUniform2f(uniforms->offset, offset[0], offset[1]);
+            haveOffset = true;
+            m_StateChanges++;
+        }
+
+        GLCall(glDrawElements(GL_TRIANGLES, command.mesh.indexCount, GL_UNSIGNED_INT, nullptr));
+        m_DrawCalls++;
+    }
+
+    // draw code that doesn't go through here (the hud) expects no offset
+    if (haveOffset && (offset[0] != 0.0f || offset[1] != 0.0f))
+        glUniform2f(uniforms->offset, 0.0f, 0.0f);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <GL/glew.h>
+
+#include <vector>
+
+#include "Debug.h"
+
+#define GLCall(x) GLClearError();\
+    x;\
+    ASSERT(GLLogCall(#x, __FILE__, __LINE__))
+
+// error reporting
+
+void GLClearError();
+bool GLLogCall(const char* function, const char* file, int line);
+
+// command buffers
+
+// what a draw reads, the vertex layout is always tightly packed vec2 positions
+struct Mesh {
+    unsigned int vertexBuffer;
+    unsigned int indexBuffer;
+    unsigned int indexCount;
+};
+
+struct DrawCommand {
+    unsigned long long key; // layer, program, vertex buffer then index buffer, filled in by Draw
+    unsigned int program;
+    Mesh mesh;
+    unsigned char color[3];
+    float offset[2]; // the only transform the shader has, added to every vertex
+};
+
+// game code records draws here, no gl calls happen until a Renderer submits it so this works on any thread
+class CommandBuffer {
+public:
+    // draws are sorted by layer first, so a lower layer is always drawn under a higher one
+    // inside a layer the order is whatever needs the fewest state changes
+    void Draw(unsigned int layer, unsigned int program, const Mesh& mesh,
+        unsigned char r, unsigned char g, unsigned char b, float offsetX = 0.0f, float offsetY = 0.0f);
+
+    void Clear() { m_Commands.clear(); }
+    bool Empty() const { return m_Commands.empty(); }
+
+    std::vector<DrawCommand>& Commands() { return m_Commands; }
+
+private:
+    std::vector<DrawCommand> m_Commands;
+};
+
+// turns command buffers into gl calls
+class Renderer {
+public:
+    Renderer();
+
+    // sorts the commands, draws them skipping any bind or uniform that wouldn't change, then clears the buffer
+    // gl state is assumed unknown at the start so other draw code can run between submits
+    // the program and buffers stay bound afterwards, u_Offset is put back to zero
+    void Submit(CommandBuffer& commands);
+
+    // totals since the last ResetStats
+    unsigned int DrawCalls() const { return m_DrawCalls; }
+    unsigned int StateChanges() const { return m_StateChanges; }
+    void ResetStats();
+
+private:
+    struct ProgramUniforms {
+        unsigned int program;
+        int color; // u_Color
+        int offset; // u_Offset
+    };
+
+    const ProgramUniforms& Uniforms(unsigned int program);
+
+    std::vector<ProgramUniforms> m_Uniforms; // one per program seen, there are only ever a couple
+    std::vector<DrawCommand> m_Sorted;
+    unsigned int m_DrawCalls;
+    unsigned int m_StateChanges;
+};
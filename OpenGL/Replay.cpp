@@ -0,0 +1,37 @@
+#include "Replay.h"
+
+#include <iostream>
+#include <fstream>
+
+const unsigned int replayMagic = 0x59414C50; // "PLAY"
+const unsigned int replayVersion = 1;
+
+bool SaveReplay(const char* path, const Replay& replay) {
+    std::ofstream out(path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "[Replay] couldn't write " << path << std::endl;
+        return false;
+    }
+
+    unsigned int header[] = { replayMagic, replayVersion, replay.seed, (unsigned int)replay.inputs.size() };
+    out.write((const char*)header, sizeof(header));
+    out.write((const char*)replay.inputs.data(), replay.inputs.size() * sizeof(float));
+    return true;
+}
+
+bool LoadReplay(const char* path, Replay& replay) {
+    std::ifstream in(path, std::ios::binary);
+    unsigned int header[4];
+    if (!in.is_open() || !in.read((char*)header, sizeof(header)) || header[0] != replayMagic || header[1] != replayVersion) {
+        std::cerr << "[Replay] " << path << " isn't a replay" << std::endl;
+        return false;
+    }
+
+    replay.seed = header[2];
+    replay.inputs.resize(header[3]);
+    if (!in.read((char*)replay.inputs.data(), replay.inputs.size() * sizeof(float))) {
+        std::cerr << "[Replay] " << path << " is cut short" << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <vector>
+
+// matches are deterministic so a seed and the player's input for every tick is enough to play one back
+struct Replay {
+    unsigned int seed;
+    std::vector<float> inputs; // vert for each tick
+};
+
+bool SaveReplay(const char* path, const Replay& replay);
+bool LoadReplay(const char* path, Replay& replay);
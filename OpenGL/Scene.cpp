@@ -0,0 +1,156 @@
+#include "Scene.h"
+
+#include "Renderer.h"
+#include "Shader.h"
+#include "Match.h"
+#include "Mesh.h"
+#include "Profiler.h"
+#include "SdfBatch.h"
+#include "EntityStore.h"
+
+void CreateScene(Scene& scene) {
+    unsigned int background[] = {
+        16, 17, 18,
+        18, 19, 16
+    };
+
+    constexpr std::array<unsigned int, 6 * 3> ball = PolygonIndices<8>(4); // the ball's corners start at vertex 4
+
+    unsigned int player1[] = { // must be unsigned
+        0, 1, 2,
+        2, 3, 0
+    };
+
+    unsigned int player2[] = {
+        12, 13, 14,
+        14, 15, 12
+    };
+
+    // core profile contexts (the headless one) won't draw without a vertex array bound
+    glGenVertexArrays(1, &scene.vao);
+    glBindVertexArray(scene.vao);
+
+    glGenBuffers(1, &scene.buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, scene.buffer);
+    glBufferData(GL_ARRAY_BUFFER, floatCount * sizeof(float), start, GL_DYNAMIC_DRAW); // change to dynamic when moving
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, 0);
+
+    glGenBuffers(1, &scene.backgroundibo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, scene.backgroundibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, 2 * 3 * sizeof(unsigned int), background, GL_STATIC_DRAW); // change to dynamic when moving
+
+    glGenBuffers(1, &scene.ballibo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, scene.ballibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, ball.size() * sizeof(unsigned int), ball.data(), GL_STATIC_DRAW); // change to dynamic when moving
+
+    glGenBuffers(1, &scene.player1ibo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, scene.player1ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, 2 * 3 * sizeof(unsigned int), player1, GL_STATIC_DRAW); // change to dynamic when moving
+
+    GLCall(glGenBuffers(1, &scene.player2ibo));
+    GLCall(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, scene.player2ibo));
+    GLCall(glBufferData(GL_ELEMENT_ARRAY_BUFFER, 2 * 3 * sizeof(unsigned int), player2, GL_STATIC_DRAW)); // change to dynamic when moving
+
+    ShaderProgramSource source = ParseShader("res/shaders/Vertex.shader", "res/shaders/Fragment.shader"); // get shaders from files
+
+    scene.shader = CreateShader(source.VertexSource, source.FragmentSource); // compile shaders
+    glUseProgram(scene.shader);
+
+    scene.location = glGetUniformLocation(scene.shader, "u_Color");
+    ASSERT(scene.location != -1); //location of -1 means it couldn't be found
+    SetUniformColor(scene.location, 0, 0, 0); // init to black
+    //glUniform4f(location, (static_cast<GLfloat>(0) / 255), (static_cast<GLfloat>(29) / 255), (static_cast<GLfloat>(102) / 255), 1.0f); // 0, 29, 102 or #001d66
+
+    scene.offsetLocation = glGetUniformLocation(scene.shader, "u_Offset");
+    ASSERT(scene.offsetLocation != -1);
+    glUniform2f(scene.offsetLocation, 0.0f, 0.0f);
+
+    // unbind everything
+    //glUseProgram(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+}
+
+void SetUniformColor(int location, unsigned char r, unsigned char g, unsigned char b) {
+    glUniform4f(location, (static_cast<GLfloat>(r) / 255), (static_cast<GLfloat>(g) / 255), (static_cast<GLfloat>(b) / 255), 1.0f);
+}
+
+void UploadScene(const Scene& scene, const float* positions) {
+    PROFILE_SCOPE("upload");
+    PROFILE_GPU_SCOPE("upload");
+
+    glBindBuffer(GL_ARRAY_BUFFER, scene.buffer);
+    glBufferData(GL_ARRAY_BUFFER, floatCount * sizeof(float), positions, GL_DYNAMIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(float) * 2, 0);
+}
+
+Mesh BackgroundMesh(const Scene& scene) {
+    Mesh mesh = { scene.buffer, scene.backgroundibo, 6 };
+    return mesh;
+}
+
+Mesh BallMesh(const Scene& scene) {
+    Mesh mesh = { scene.buffer, scene.ballibo, 18 };
+    return mesh;
+}
+
+Mesh Player1Mesh(const Scene& scene) {
+    Mesh mesh = { scene.buffer, scene.player1ibo, 6 };
+    return mesh;
+}
+
+Mesh Player2Mesh(const Scene& scene) {
+    Mesh mesh = { scene.buffer, scene.player2ibo, 6 };
+    return mesh;
+}
+
+void RecordBackground(const Scene& scene, CommandBuffer& commands) {
+    commands.Draw(LAYER_BACKGROUND, scene.shader, BackgroundMesh(scene), 0, 29, 102);
+}
+
+void RecordScene(const Scene& scene, CommandBuffer& commands) {
+    RecordBackground(scene, commands);
+    commands.Draw(LAYER_BALL, scene.shader, BallMesh(scene), 255, 255, 255);
+    commands.Draw(LAYER_PADDLES, scene.shader, Player2Mesh(scene), 0, 140, 255);
+}
+
+void RecordPlayer1(const Scene& scene, CommandBuffer& commands, float offset) {
+    commands.Draw(LAYER_PADDLES, scene.shader, Player1Mesh(scene), 0, 140, 255, 0.0f, offset);
+}
+
+// paddles get corners just round enough to see at 1080p
+const float paddleCornerRadius = 0.004f;
+
+static void DrawPaddleSdf(SdfBatch& batch, const float* quad) {
+    batch.DrawRoundedRect(quad[0], quad[1], quad[4], quad[5], paddleCornerRadius, 0, 140, 255);
+}
+
+void DrawShapesSdf(SdfBatch& batch, const float* positions, float player1Offset) {
+    // the ball's polygon is centered on the ball
+    float x = 0.0f, y = 0.0f;
+    for (int i = 8; i < 24; i += 2) {
+        x += positions[i];
+        y += positions[i + 1];
+    }
+    batch.DrawCircle(x / 8, y / 8, size, 255, 255, 255);
+
+    DrawPaddleSdf(batch, positions + 24); // player 2
+
+    batch.SetOffset(0.0f, player1Offset);
+    DrawPaddleSdf(batch, positions); // player 1
+    batch.Flush();
+    batch.SetOffset(0.0f, 0.0f);
+}
+
+void DrawEntities(const EntityStore& store, SdfBatch& batch) {
+    for (size_t i = 0; i < EntityCount(store); i++) {
+        float x = store.x[i], y = store.y[i], w = store.halfWidth[i], h = store.halfHeight[i];
+        if (store.shape[i] == COLLIDER_CIRCLE)
+            batch.DrawCircle(x, y, w, store.r[i], store.g[i], store.b[i]);
+        else if (store.shape[i] == COLLIDER_BOX)
+            batch.DrawRoundedRect(x - w, y - h, x + w, y + h, paddleCornerRadius, store.r[i], store.g[i], store.b[i]);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Renderer.h"
+
+class SdfBatch;
+struct EntityStore;
+
+// the gl objects for drawing a match, shared by the window and the offscreen paths
+struct Scene {
+    unsigned int vao;
+    unsigned int buffer;
+    unsigned int backgroundibo;
+    unsigned int ballibo;
+    unsigned int player1ibo;
+    unsigned int player2ibo;
+    unsigned int shader;
+    int location; // u_Color
+    int offsetLocation; // u_Offset
+};
+
+// loads the shaders from res/shaders and leaves the program bound, needs a current context
+void CreateScene(Scene& scene);
+
+void SetUniformColor(int location, unsigned char r, unsigned char g, unsigned char b);
+
+void UploadScene(const Scene& scene, const float* positions);
+
+// draw order, paddles go over the ball
+enum SceneLayer {
+    LAYER_BACKGROUND,
+    LAYER_BALL,
+    LAYER_PADDLES
+};
+
+Mesh BackgroundMesh(const Scene& scene);
+Mesh BallMesh(const Scene& scene);
+Mesh Player1Mesh(const Scene& scene);
+Mesh Player2Mesh(const Scene& scene);
+
+void RecordBackground(const Scene& scene, CommandBuffer& commands);
+
+// background, ball and player 2
+void RecordScene(const Scene& scene, CommandBuffer& commands);
+
+// player 1 is recorded on its own so the low latency mode can submit it last thing before the swap
+void RecordPlayer1(const Scene& scene, CommandBuffer& commands, float offset);
+
+// the ball and both paddles as distance field shapes instead of the polygons, goes after RecordBackground
+// the ball comes out as a smooth circle, player 1 is drawn last with its own offset like RecordPlayer1
+void DrawShapesSdf(SdfBatch& batch, const float* positions, float player1Offset);
+
+// every entity with a collider, boxes as the paddles' rounded rectangles and circles as balls
+// doesn't flush so it can be batched with other shapes
+void DrawEntities(const EntityStore& store, SdfBatch& batch);
@@ -0,0 +1,141 @@
+#include "SdfBatch.h"
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+#include "Renderer.h"
+#include "Shader.h"
+
+SdfBatch::SdfBatch(int width, int height, unsigned int capacity)
+    : m_Capacity(capacity - capacity % 6), m_Width((float)width), m_Height((float)height),
+    m_Vertices(capacity - capacity % 6), m_Count(0), m_DrawCalls(0), m_BytesUploaded(0) {
+    m_Offset[0] = 0.0f;
+    m_Offset[1] = 0.0f;
+
+    ShaderProgramSource source = ParseShader("res/shaders/SdfVertex.shader", "res/shaders/SdfFragment.shader");
+    m_Program = CreateShader(source.VertexSource, source.FragmentSource);
+    m_OffsetLocation = glGetUniformLocation(m_Program, "u_Offset");
+    ASSERT(m_OffsetLocation != -1);
+
+    GLint program, vao;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+
+    glUseProgram(m_Program);
+    glUniform2f(m_OffsetLocation, 0.0f, 0.0f);
+
+    glGenVertexArrays(1, &m_Vao);
+    glBindVertexArray(m_Vao);
+
+    glGenBuffers(1, &m_Buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+    glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(SdfVertex), nullptr, GL_STREAM_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SdfVertex), (const void*)offsetof(SdfVertex, x));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SdfVertex), (const void*)offsetof(SdfVertex, localX));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(SdfVertex), (const void*)offsetof(SdfVertex, halfWidth));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SdfVertex), (const void*)offsetof(SdfVertex, color));
+
+    glBindVertexArray(vao);
+    glUseProgram(program);
+}
+
+void SdfBatch::SetViewport(int width, int height) {
+    m_Width = (float)width;
+    m_Height = (float)height;
+}
+
+void SdfBatch::ResetStats() {
+    m_DrawCalls = 0;
+    m_BytesUploaded = 0;
+}
+
+void SdfBatch::AddShape(float x, float y, float halfWidth, float halfHeight, float radius, unsigned char r, unsigned char g, unsigned char b) {
+    if (m_Count + 6 > m_Capacity)
+        Flush();
+
+    // one pixel of padding so the fade past the edge isn't cut off
+    float padX = halfWidth + 1.0f, padY = halfHeight + 1.0f;
+    float dx = padX * 2.0f / m_Width, dy = padY * 2.0f / m_Height;
+
+    const float corners[6][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { 1, 1 }, { -1, 1 }, { -1, -1 } };
+    SdfVertex* v = &m_Vertices[m_Count];
+    for (int i = 0; i < 6; i++) {
+        v[i].x = x + corners[i][0] * dx;
+        v[i].y = y + corners[i][1] * dy;
+        v[i].localX = corners[i][0] * padX;
+        v[i].localY = corners[i][1] * padY;
+        v[i].halfWidth = halfWidth;
+        v[i].halfHeight = halfHeight;
+        v[i].radius = radius;
+        v[i].color[0] = r;
+        v[i].color[1] = g;
+        v[i].color[2] = b;
+        v[i].color[3] = 255;
+    }
+    m_Count += 6;
+}
+
+void SdfBatch::DrawCircle(float x, float y, float radius, unsigned char r, unsigned char g, unsigned char b) {
+    float pixels = radius * m_Width * 0.5f;
+    AddShape(x, y, pixels, pixels, pixels, r, g, b);
+}
+
+void SdfBatch::DrawRoundedRect(float x1, float y1, float x2, float y2, float cornerRadius, unsigned char r, unsigned char g, unsigned char b) {
+    float halfWidth = (x2 > x1 ? x2 - x1 : x1 - x2) * m_Width * 0.25f;
+    float halfHeight = (y2 > y1 ? y2 - y1 : y1 - y2) * m_Height * 0.25f;
+    float radius = cornerRadius * m_Width * 0.5f;
+
+    // the radius can't be more than half the shorter side
+    if (radius > halfWidth)
+        radius = halfWidth;
+    if (radius > halfHeight)
+        radius = halfHeight;
+
+    AddShape((x1 + x2) * 0.5f, (y1 + y2) * 0.5f, halfWidth, halfHeight, radius, r, g, b);
+}
+
+void SdfBatch::SetOffset(float x, float y) {
+    if (x == m_Offset[0] && y == m_Offset[1])
+        return;
+    Flush();
+    m_Offset[0] = x;
+    m_Offset[1] = y;
+}
+
+void SdfBatch::Flush() {
+    if (m_Count == 0)
+        return;
+
+    GLint program, vao;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+    GLboolean blend = glIsEnabled(GL_BLEND);
+
+    glUseProgram(m_Program);
+    glUniform2f(m_OffsetLocation, m_Offset[0], m_Offset[1]);
+    glBindVertexArray(m_Vao);
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    // orphan the old storage so the driver doesn't wait for the last draw that used it
+    glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+    glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(SdfVertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, m_Count * sizeof(SdfVertex), m_Vertices.data());
+
+    GLCall(glDrawArrays(GL_TRIANGLES, 0, m_Count));
+
+    m_DrawCalls++;
+    m_BytesUploaded += m_Count * sizeof(SdfVertex);
+    m_Count = 0;
+
+    if (!blend)
+        glDisable(GL_BLEND);
+    glBindVertexArray(vao);
+    glUseProgram(program);
+}
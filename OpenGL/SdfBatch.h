@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+
+struct SdfVertex {
+    float x, y;
+    float localX, localY; // pixels from the shape's center
+    float halfWidth, halfHeight, radius; // the shape in pixels
+    unsigned char color[4];
+};
+
+// circles and rounded rectangles drawn as one quad each, the fragment shader works out coverage from the distance to the edge
+// edges are anti-aliased and round at any size, where ShapeBatch needs more triangles the bigger a circle gets
+// works like ShapeBatch: one streaming buffer, a draw call when it fills up, the offset changes or Flush is called
+class SdfBatch {
+public:
+    // loads res/shaders/SdfVertex.shader and SdfFragment.shader, needs the gl context and the buffer goes away with it
+    // width and height are the viewport in pixels, shapes are sized in pixels so circles stay round at any aspect
+    SdfBatch(int width, int height, unsigned int capacity = 1 << 18);
+
+    void SetViewport(int width, int height);
+
+    // radius is in clip space along x
+    void DrawCircle(float x, float y, float radius, unsigned char r, unsigned char g, unsigned char b);
+
+    // cornerRadius is in clip space along x too
+    void DrawRoundedRect(float x1, float y1, float x2, float y2, float cornerRadius, unsigned char r, unsigned char g, unsigned char b);
+
+    // moves everything drawn after this, flushes first if it changed
+    void SetOffset(float x, float y);
+
+    // draws everything queued with blending on, the program, vertex array and blend state from before are put back
+    void Flush();
+
+    // totals since the last ResetStats
+    unsigned int DrawCalls() const { return m_DrawCalls; }
+    unsigned int BytesUploaded() const { return m_BytesUploaded; }
+    void ResetStats();
+
+private:
+    // a quad around center with the given half size in pixels, padded by a pixel for the fade
+    void AddShape(float x, float y, float halfWidth, float halfHeight, float radius, unsigned char r, unsigned char g, unsigned char b);
+
+    unsigned int m_Capacity;
+    float m_Width;
+    float m_Height;
+    unsigned int m_Program;
+    int m_OffsetLocation;
+    unsigned int m_Vao;
+    unsigned int m_Buffer;
+    std::vector<SdfVertex> m_Vertices; // never grows past capacity so it never reallocates
+    unsigned int m_Count; // vertices queued
+    float m_Offset[2];
+    unsigned int m_DrawCalls;
+    unsigned int m_BytesUploaded;
+};
@@ -0,0 +1,145 @@
+#include "Search.h"
+
+#include <cmath>
+#include <climits>
+
+#include "Input.h"
+#include "Timing.h"
+
+const unsigned int searchClockEvery = 8; // simulations between looks at the clock, Now() costs about as much as a few ticks
+
+static float ActionVert(unsigned int action) {
+    return action == SEARCH_UP ? paddleStep : (action == SEARCH_DOWN ? -paddleStep : 0.0f);
+}
+
+void InitSearchBot(SearchBot& bot, const SearchOptions& options) {
+    bot.options = options;
+    bot.nodes.assign(options.maxNodes < 1 + SEARCH_ACTION_COUNT ? 1 + SEARCH_ACTION_COUNT : options.maxNodes, SearchNode());
+    bot.nodeCount = 0;
+    bot.stats = SearchStats();
+}
+
+// plays ticks on a copy of the match, side's paddle moving by vert or tracking the ball when track is set, the other one always tracking
+// same order as TickMatch, returns 1 if side won a point, -1 if it lost one and 0 if neither happened before the ticks ran out
+static int Play(MatchState& state, MatchSide side, float vert, bool track, unsigned int ticks, unsigned long long& played) {
+    const unsigned int own = state.score[side];
+    const unsigned int other = state.score[1 - side];
+    for (unsigned int t = 0; t < ticks; t++) {
+        for (int p = SIDE_LEFT; p <= SIDE_RIGHT; p++) {
+            if (p == side && !track)
+                MovePaddle(state, side, vert);
+            else
+                TrackStep(state, (MatchSide)p);
+            ClampPaddle(state, (MatchSide)p);
+        }
+        TickBall(state);
+        played++;
+
+        if (state.score[side] != own)
+            return 1;
+        if (state.score[1 - side] != other)
+            return -1;
+    }
+    return 0;
+}
+
+// gives the children room at the end of the arena, false once it's full
+static bool Expand(SearchBot& bot, unsigned int node) {
+    if (bot.nodeCount + SEARCH_ACTION_COUNT > bot.nodes.size())
+        return false;
+    const unsigned int first = bot.nodeCount;
+    for (unsigned int a = 0; a < SEARCH_ACTION_COUNT; a++)
+        bot.nodes[first + a] = { node, 0, 0, 0.0f };
+    bot.nodes[node].firstChild = first;
+    bot.nodeCount += SEARCH_ACTION_COUNT;
+    return true;
+}
+
+// ucb1, children nobody has tried yet go first
+static unsigned int Select(const SearchBot& bot, unsigned int node) {
+    const SearchNode& parent = bot.nodes[node];
+    const float logVisits = std::log((float)parent.visits);
+    unsigned int best = parent.firstChild;
+    float bestScore = -INFINITY;
+    for (unsigned int c = parent.firstChild; c < parent.firstChild + SEARCH_ACTION_COUNT; c++) {
+        const SearchNode& child = bot.nodes[c];
+        if (child.visits == 0)
+            return c;
+        float score = child.value / child.visits + bot.options.exploration * std::sqrt(logVisits / child.visits);
+        if (score > bestScore) {
+            bestScore = score;
+            best = c;
+        }
+    }
+    return best;
+}
+
+// one pass down the tree from a fresh copy of the real match, a rollout from the leaf, and the result carried back up to the root
+// with variance on the copies share the real match's rand state, so the bot knows which way the coming bounces will go
+static void Simulate(SearchBot& bot, const MatchState& root, MatchSide side) {
+    MatchState state = root;
+    unsigned long long& played = bot.stats.ticks;
+    const unsigned int actionTicks = bot.options.actionTicks;
+
+    unsigned int node = 0;
+    int reward = 0;
+    bool done = false;
+    while (!done && bot.nodes[node].firstChild != 0) {
+        node = Select(bot, node);
+        const unsigned int action = node - bot.nodes[bot.nodes[node].parent].firstChild;
+        reward = Play(state, side, ActionVert(action), false, actionTicks, played);
+        done = reward != 0;
+    }
+
+    // a leaf grows children the second time it's reached, so one off rollouts don't fill the arena
+    if (!done && bot.nodes[node].visits > 0 && Expand(bot, node)) {
+        node = bot.nodes[node].firstChild;
+        reward = Play(state, side, ActionVert(0), false, actionTicks, played);
+        done = reward != 0;
+    }
+
+    if (!done)
+        reward = Play(state, side, 0.0f, true, bot.options.rolloutTicks, played);
+
+    for (;;) {
+        SearchNode& n = bot.nodes[node];
+        n.visits++;
+        n.value += reward;
+        if (node == 0)
+            break;
+        node = n.parent;
+    }
+    bot.stats.simulations++;
+}
+
+float SearchMove(SearchBot& bot, const MatchState& state, MatchSide side) {
+    const SearchOptions& options = bot.options;
+    const double begin = Now();
+    const double deadline = begin + options.budget;
+
+    // the tree only lives for one decision, starting over from the front of the arena frees it all at once
+    bot.nodeCount = 1;
+    bot.nodes[0] = { 0, 0, 0, 0.0f };
+    Expand(bot, 0);
+
+    // with nothing to stop it it takes a single look ahead
+    const unsigned int limit = options.maxSimulations != 0 ? options.maxSimulations : (options.budget > 0.0 ? UINT_MAX : 1);
+    for (unsigned int s = 0; s < limit; s++) {
+        if (options.budget > 0.0 && s != 0 && s % searchClockEvery == 0 && Now() >= deadline)
+            break;
+        Simulate(bot, state, side);
+    }
+
+    // the most tried move, standing still when nothing stands out so the paddle doesn't jitter
+    const SearchNode& root = bot.nodes[0];
+    unsigned int best = root.firstChild + SEARCH_STAY;
+    for (unsigned int c = root.firstChild; c < root.firstChild + SEARCH_ACTION_COUNT; c++) {
+        const SearchNode& child = bot.nodes[c];
+        const SearchNode& chosen = bot.nodes[best];
+        if (child.visits > chosen.visits || (child.visits == chosen.visits && child.value > chosen.value))
+            best = c;
+    }
+
+    bot.stats.seconds += Now() - begin;
+    return ActionVert(best - root.firstChild);
+}
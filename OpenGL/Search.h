@@ -0,0 +1,63 @@
+#pragma once
+
+#include <vector>
+
+#include "Match.h"
+
+// a lookahead bot, monte carlo tree search over its own paddle's moves
+// a MatchState is plain data so a snapshot is a copy, every simulation starts from a copy of the real match,
+// plays the tree's moves and then a rollout through the same tick functions the match uses, none of which allocate
+
+enum SearchAction {
+    SEARCH_UP,
+    SEARCH_STAY,
+    SEARCH_DOWN,
+    SEARCH_ACTION_COUNT
+};
+
+struct SearchOptions {
+    double budget = 0.002; // seconds per decision, a 60hz tick leaves about 16ms, 0 for no time limit
+    // per decision, 0 for no limit, with no budget the search plays the same every run
+    // with both at 0 nothing would stop it, so it takes a single simulation
+    unsigned int maxSimulations = 0;
+    unsigned int actionTicks = 8; // how long each move in the tree is held
+    unsigned int rolloutTicks = 480; // how far past the tree a simulation looks, a serve takes about 400 ticks to cross
+    float exploration = 1.4f;
+    unsigned int maxNodes = 1 << 16; // the arena's size, the tree stops growing once it's full
+};
+
+// children are stored next to each other so a node only needs its first child's index
+struct SearchNode {
+    unsigned int parent;
+    unsigned int firstChild; // 0 until expanded, the root is never anyone's child
+    unsigned int visits;
+    float value; // total reward from the searching side's point of view
+};
+
+struct SearchStats {
+    unsigned long long simulations;
+    unsigned long long ticks; // simulated, tree and rollouts
+    double seconds;
+};
+
+struct SearchBot {
+    SearchOptions options;
+    std::vector<SearchNode> nodes; // sized once, each decision starts over from the front
+    unsigned int nodeCount;
+    SearchStats stats; // added up over every decision
+};
+
+void InitSearchBot(SearchBot& bot, const SearchOptions& options);
+
+// searches from state and returns the move for side's paddle this tick, like the vert passed to TickMatch
+// rollouts play both paddles with TrackStep, so the other paddle is assumed to play like the classic bot
+float SearchMove(SearchBot& bot, const MatchState& state, MatchSide side);
+
+// a controller for Match that searches every tick, the bot isn't owned
+struct SearchPolicy {
+    SearchBot* bot = nullptr;
+
+    void Move(MatchState& state, MatchSide side) {
+        MovePaddle(state, side, SearchMove(*bot, state, side));
+    }
+};
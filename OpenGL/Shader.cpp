@@ -0,0 +1,69 @@
+#include "Shader.h"
+
+#include <GL/glew.h>
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+
+ShaderProgramSource ParseShader(const std::string& vertex, const std::string& fragment) {
+
+    std::ifstream vertexstream(vertex);
+    std::string vertexout;
+    if (vertexstream.is_open()) {
+        while (vertexstream) {
+            vertexout += vertexstream.get();
+        }
+    }
+
+    std::ifstream fragmentstream(fragment);
+    std::string fragmentout;
+    if (fragmentstream.is_open()) {
+        while (fragmentstream) {
+            fragmentout += fragmentstream.get();
+        }
+    }
+
+    vertexout.resize(vertexout.size() - 1); // removes the last character from both strings because it was a weird character causing problems
+    fragmentout.resize(fragmentout.size() - 1);
+
+    return { vertexout, fragmentout };
+}
+
+unsigned int CompileShader(unsigned int type, const std::string& source) {
+    unsigned int id = glCreateShader(type);
+    const char* src = source.c_str();
+    glShaderSource(id, 1, &src, nullptr);
+    glCompileShader(id);
+    
+    int result;
+    glGetShaderiv(id, GL_COMPILE_STATUS, &result);
+    if (result == GL_FALSE) {
+        int length;
+        glGetShaderiv(id, GL_INFO_LOG_LENGTH, &length);
+        std::vector<char> message(length);
+        glGetShaderInfoLog(id, length, &length, message.data());
+        std::cout << "Failed to compile " << 
+            (type == GL_VERTEX_SHADER ? "vertex" : "fragment") << " shader" << std::endl;
+        std::cout << message.data() << std::endl;
+        glDeleteShader(id);
+        return 0;
+    }
+    return id;
+}
+
+unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader) {
+    unsigned int program = glCreateProgram();
+    unsigned int vs = CompileShader(GL_VERTEX_SHADER, vertexShader);
+    unsigned int fs = CompileShader(GL_FRAGMENT_SHADER, fragmentShader);
+
+    glAttachShader(program, vs);
+    glAttachShader(program, fs);
+    glLinkProgram(program);
+    glValidateProgram(program);
+
+    glDeleteShader(vs);
+    glDeleteShader(fs);
+
+    return program;
+}
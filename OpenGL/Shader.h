@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+
+struct ShaderProgramSource {
+    std::string VertexSource;
+    std::string FragmentSource;
+};
+
+ShaderProgramSource ParseShader(const std::string& vertex, const std::string& fragment);
+unsigned int CompileShader(unsigned int type, const std::string& source);
+unsigned int CreateShader(const std::string& vertexShader, const std::string& fragmentShader);
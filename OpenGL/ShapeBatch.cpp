@@ -0,0 +1,185 @@
+#include "ShapeBatch.h"
+
+#include <GL/glew.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include "Renderer.h"
+#include "Shader.h"
+#include "Match.h"
+#include "Mesh.h"
+
+ShapeBatch::ShapeBatch(unsigned int capacity, float aspect)
+    : m_Capacity(capacity - capacity % 3), m_Aspect(aspect), m_Vertices(capacity - capacity % 3), m_Count(0),
+    m_DrawCalls(0), m_BytesUploaded(0) {
+    m_Offset[0] = 0.0f;
+    m_Offset[1] = 0.0f;
+
+    ShaderProgramSource source = ParseShader("res/shaders/BatchVertex.shader", "res/shaders/BatchFragment.shader");
+    m_Program = CreateShader(source.VertexSource, source.FragmentSource);
+    m_OffsetLocation = glGetUniformLocation(m_Program, "u_Offset");
+    ASSERT(m_OffsetLocation != -1);
+
+    GLint program, vao;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+
+    glUseProgram(m_Program);
+    glUniform2f(m_OffsetLocation, 0.0f, 0.0f);
+
+    // its own vertex array so the scene's attribute setup is never touched
+    glGenVertexArrays(1, &m_Vao);
+    glBindVertexArray(m_Vao);
+
+    glGenBuffers(1, &m_Buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+    glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(ShapeVertex), nullptr, GL_STREAM_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(ShapeVertex), (const void*)offsetof(ShapeVertex, x));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ShapeVertex), (const void*)offsetof(ShapeVertex, color));
+
+    glBindVertexArray(vao);
+    glUseProgram(program);
+}
+
+void ShapeBatch::ResetStats() {
+    m_DrawCalls = 0;
+    m_BytesUploaded = 0;
+}
+
+ShapeVertex* ShapeBatch::Reserve(unsigned int count) {
+    ASSERT(count <= m_Capacity);
+    if (m_Count + count > m_Capacity)
+        Flush();
+    ShapeVertex* out = &m_Vertices[m_Count];
+    m_Count += count;
+    return out;
+}
+
+static void SetVertex(ShapeVertex& vertex, float x, float y, unsigned char r, unsigned char g, unsigned char b) {
+    vertex.x = x;
+    vertex.y = y;
+    vertex.color[0] = r;
+    vertex.color[1] = g;
+    vertex.color[2] = b;
+    vertex.color[3] = 255;
+}
+
+void ShapeBatch::DrawQuad(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b) {
+    ShapeVertex* v = Reserve(6);
+    SetVertex(v[0], x1, y1, r, g, b);
+    SetVertex(v[1], x2, y1, r, g, b);
+    SetVertex(v[2], x2, y2, r, g, b);
+    SetVertex(v[3], x2, y2, r, g, b);
+    SetVertex(v[4], x1, y2, r, g, b);
+    SetVertex(v[5], x1, y1, r, g, b);
+}
+
+void ShapeBatch::DrawCircle(float x, float y, float radius, unsigned int sides, unsigned char r, unsigned char g, unsigned char b) {
+    if (sides < 3)
+        sides = 3;
+
+    // the common side counts are baked in already, no trig at all
+    CircleLod lod;
+    if (FindCircleLod(sides, lod)) {
+        MeshView mesh = CircleMesh(lod);
+        ShapeVertex* v = Reserve(mesh.indexCount);
+        for (unsigned int i = 0; i < mesh.indexCount; i++) {
+            const float* corner = mesh.vertices + mesh.indices[i] * 2;
+            SetVertex(v[i], x + corner[0] * radius, y + corner[1] * radius * m_Aspect, r, g, b);
+        }
+        return;
+    }
+
+    // a fan from the first corner, sides - 2 triangles
+    // reserved a buffer's worth at a time, a fan too big for one flush goes out over several
+    unsigned int triangles = sides - 2;
+    unsigned int room = 0;
+    ShapeVertex* v = nullptr;
+
+    // walk the corners by rotating instead of calling cos and sin for each one
+    float step = (float)(2 * pi / sides);
+    float stepCos = std::cos(step), stepSin = std::sin(step);
+    float dx = radius, dy = 0.0f;
+
+    float firstX = x + dx, firstY = y;
+    float prevX = 0.0f, prevY = 0.0f;
+    for (unsigned int i = 1; i < sides; i++) {
+        float nx = dx * stepCos - dy * stepSin;
+        dy = dx * stepSin + dy * stepCos;
+        dx = nx;
+        float cornerX = x + dx, cornerY = y + dy * m_Aspect;
+        if (i >= 2) {
+            if (room == 0) {
+                room = std::min(triangles, m_Capacity / 3);
+                triangles -= room;
+                v = Reserve(room * 3);
+            }
+            SetVertex(v[0], firstX, firstY, r, g, b);
+            SetVertex(v[1], prevX, prevY, r, g, b);
+            SetVertex(v[2], cornerX, cornerY, r, g, b);
+            v += 3;
+            room--;
+        }
+        prevX = cornerX;
+        prevY = cornerY;
+    }
+}
+
+void ShapeBatch::DrawLine(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b) {
+    float dx = x2 - x1, dy = y2 - y1;
+    float length = std::sqrt(dx * dx + dy * dy);
+    if (length == 0.0f)
+        return;
+
+    // half the thickness out to each side
+    float nx = -dy / length * thickness * 0.5f;
+    float ny = dx / length * thickness * 0.5f;
+
+    ShapeVertex* v = Reserve(6);
+    SetVertex(v[0], x1 + nx, y1 + ny, r, g, b);
+    SetVertex(v[1], x1 - nx, y1 - ny, r, g, b);
+    SetVertex(v[2], x2 - nx, y2 - ny, r, g, b);
+    SetVertex(v[3], x2 - nx, y2 - ny, r, g, b);
+    SetVertex(v[4], x2 + nx, y2 + ny, r, g, b);
+    SetVertex(v[5], x1 + nx, y1 + ny, r, g, b);
+}
+
+void ShapeBatch::SetOffset(float x, float y) {
+    if (x == m_Offset[0] && y == m_Offset[1])
+        return;
+    Flush();
+    m_Offset[0] = x;
+    m_Offset[1] = y;
+}
+
+void ShapeBatch::Flush() {
+    if (m_Count == 0)
+        return;
+
+    GLint program, vao;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vao);
+
+    glUseProgram(m_Program);
+    glUniform2f(m_OffsetLocation, m_Offset[0], m_Offset[1]);
+    glBindVertexArray(m_Vao);
+
+    // orphan the old storage so the driver doesn't wait for the last draw that used it
+    glBindBuffer(GL_ARRAY_BUFFER, m_Buffer);
+    glBufferData(GL_ARRAY_BUFFER, m_Capacity * sizeof(ShapeVertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, m_Count * sizeof(ShapeVertex), m_Vertices.data());
+
+    GLCall(glDrawArrays(GL_TRIANGLES, 0, m_Count));
+
+    m_DrawCalls++;
+    m_BytesUploaded += m_Count * sizeof(ShapeVertex);
+    m_Count = 0;
+
+    glBindVertexArray(vao);
+    glUseProgram(program);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+
+struct ShapeVertex {
+    float x, y;
+    unsigned char color[4];
+};
+
+// immediate mode shapes in clip space, everything goes into one streaming buffer
+// a draw call only happens when the buffer fills up, the offset changes or Flush is called
+class ShapeBatch {
+public:
+    // loads res/shaders/BatchVertex.shader and BatchFragment.shader, needs the gl context and the buffer goes away with it
+    // capacity is in vertices, aspect is how much circles get stretched vertically (same as the ball for a 16:9 window)
+    explicit ShapeBatch(unsigned int capacity = 1 << 18, float aspect = 16.0f / 9);
+
+    void DrawQuad(float x1, float y1, float x2, float y2, unsigned char r, unsigned char g, unsigned char b);
+
+    // regular polygon with sides corners, radius is horizontal, a polygon too big for the buffer is drawn over several flushes
+    void DrawCircle(float x, float y, float radius, unsigned int sides, unsigned char r, unsigned char g, unsigned char b);
+
+    void DrawLine(float x1, float y1, float x2, float y2, float thickness, unsigned char r, unsigned char g, unsigned char b);
+
+    // moves everything drawn after this, flushes first if it changed
+    void SetOffset(float x, float y);
+
+    // draws everything queued, the program and vertex array that were bound before are put back
+    void Flush();
+
+    // totals since the last ResetStats
+    unsigned int DrawCalls() const { return m_DrawCalls; }
+    unsigned int BytesUploaded() const { return m_BytesUploaded; }
+    void ResetStats();
+
+private:
+    // flushes if count more vertices wouldn't fit, returns where to write them
+    ShapeVertex* Reserve(unsigned int count);
+
+    unsigned int m_Capacity;
+    float m_Aspect;
+    unsigned int m_Program;
+    int m_OffsetLocation;
+    unsigned int m_Vao;
+    unsigned int m_Buffer;
+    std::vector<ShapeVertex> m_Vertices; // never grows past capacity so it never reallocates
+    unsigned int m_Count; // vertices queued
+    float m_Offset[2];
+    unsigned int m_DrawCalls;
+    unsigned int m_BytesUploaded;
+};
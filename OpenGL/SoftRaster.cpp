@@ -0,0 +1,170 @@
+#include "SoftRaster.h"
+
+#include <cmath>
+
+#include "JobSystem.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+// same colors DrawScene sets
+static const unsigned char backgroundColor[3] = { 0, 29, 102 };
+static const unsigned char ballColor[3] = { 255, 255, 255 };
+static const unsigned char paddleColor[3] = { 0, 140, 255 };
+
+struct RasterPaint {
+    RasterFormat format;
+    unsigned char gray;
+    unsigned char rgb[3];
+};
+
+static RasterPaint MakePaint(RasterFormat format, const unsigned char* rgb) {
+    RasterPaint paint;
+    paint.format = format;
+    paint.gray = (unsigned char)((77 * rgb[0] + 150 * rgb[1] + 29 * rgb[2] + 128) >> 8);
+    paint.rgb[0] = rgb[0];
+    paint.rgb[1] = rgb[1];
+    paint.rgb[2] = rgb[2];
+    return paint;
+}
+
+// fills count pixels starting at dst, this is where nearly all the time goes
+static void FillSpan(unsigned char* dst, size_t count, const RasterPaint& paint) {
+    size_t i = 0;
+    if (paint.format == RASTER_GRAY) {
+#ifdef RASTER_SSE2
+        __m128i value = _mm_set1_epi8((char)paint.gray);
+        for (; i + 16 <= count; i += 16)
+            _mm_storeu_si128((__m128i*)(dst + i), value);
+#endif
+        for (; i < count; i++)
+            dst[i] = paint.gray;
+    }
+    else {
+#ifdef RASTER_SSE2
+        // 16 rgb pixels are exactly three registers of the repeating pattern
+        alignas(16) unsigned char pattern[48];
+        for (int p = 0; p < 48; p++)
+            pattern[p] = paint.rgb[p % 3];
+        __m128i a = _mm_load_si128((const __m128i*)pattern);
+        __m128i b = _mm_load_si128((const __m128i*)(pattern + 16));
+        __m128i c = _mm_load_si128((const __m128i*)(pattern + 32));
+        for (; i + 16 <= count; i += 16) {
+            unsigned char* out = dst + i * 3;
+            _mm_storeu_si128((__m128i*)out, a);
+            _mm_storeu_si128((__m128i*)(out + 16), b);
+            _mm_storeu_si128((__m128i*)(out + 32), c);
+        }
+#endif
+        for (; i < count; i++) {
+            dst[i * 3] = paint.rgb[0];
+            dst[i * 3 + 1] = paint.rgb[1];
+            dst[i * 3 + 2] = paint.rgb[2];
+        }
+    }
+}
+
+// first pixel whose center is at or past edge, clamped to [0, limit]
+static int FirstCovered(float edge, int limit) {
+    float first = std::ceil(edge - 0.5f);
+    if (first < 0.0f)
+        return 0;
+    if (first > (float)limit)
+        return limit;
+    return (int)first;
+}
+
+struct RasterTarget {
+    unsigned char* pixels;
+    int width;
+    int height;
+    size_t bytesPerPixel;
+};
+
+// ndc to pixel space with y going down
+static float PixelX(const RasterTarget& target, float x) {
+    return (x + 1.0f) * 0.5f * target.width;
+}
+
+static float PixelY(const RasterTarget& target, float y) {
+    return (1.0f - y) * 0.5f * target.height;
+}
+
+static void FillRow(const RasterTarget& target, int row, float left, float right, const RasterPaint& paint) {
+    int x0 = FirstCovered(left, target.width);
+    int x1 = FirstCovered(right, target.width);
+    if (x1 > x0)
+        FillSpan(target.pixels + ((size_t)row * target.width + x0) * target.bytesPerPixel, x1 - x0, paint);
+}
+
+// a paddle, the four corners in positions can come in any order
+static void FillQuad(const RasterTarget& target, const float* quad, const RasterPaint& paint) {
+    float left = quad[0], right = quad[0], bottom = quad[1], top = quad[1];
+    for (int i = 2; i < 8; i += 2) {
+        left = quad[i] < left ? quad[i] : left;
+        right = quad[i] > right ? quad[i] : right;
+        bottom = quad[i + 1] < bottom ? quad[i + 1] : bottom;
+        top = quad[i + 1] > top ? quad[i + 1] : top;
+    }
+
+    int y0 = FirstCovered(PixelY(target, top), target.height);
+    int y1 = FirstCovered(PixelY(target, bottom), target.height);
+    float l = PixelX(target, left);
+    float r = PixelX(target, right);
+    for (int row = y0; row < y1; row++)
+        FillRow(target, row, l, r, paint);
+}
+
+// the ball, any convex polygon works
+static void FillConvex(const RasterTarget& target, const float* points, int count, const RasterPaint& paint) {
+    float x[16], y[16];
+    float top = 1e30f, bottom = -1e30f;
+    for (int i = 0; i < count; i++) {
+        x[i] = PixelX(target, points[i * 2]);
+        y[i] = PixelY(target, points[i * 2 + 1]);
+        top = y[i] < top ? y[i] : top;
+        bottom = y[i] > bottom ? y[i] : bottom;
+    }
+
+    int y0 = FirstCovered(top, target.height);
+    int y1 = FirstCovered(bottom, target.height);
+    for (int row = y0; row < y1; row++) {
+        float center = row + 0.5f;
+        float left = 1e30f, right = -1e30f;
+        for (int i = 0, j = count - 1; i < count; j = i++) {
+            // every edge the row's center line crosses gives one end of the span
+            if ((y[i] <= center) == (y[j] <= center))
+                continue;
+            float cross = x[j] + (center - y[j]) * (x[i] - x[j]) / (y[i] - y[j]);
+            left = cross < left ? cross : left;
+            right = cross > right ? cross : right;
+        }
+        if (right > left)
+            FillRow(target, row, left, right, paint);
+    }
+}
+
+void RasterizeMatch(const float* positions, int width, int height, RasterFormat format, unsigned char* pixels) {
+    RasterTarget target = { pixels, width, height, format == RASTER_RGB ? (size_t)3 : (size_t)1 };
+
+    // rows are contiguous so the background is one long span
+    FillSpan(pixels, (size_t)width * height, MakePaint(format, backgroundColor));
+
+    FillConvex(target, positions + 8, 8, MakePaint(format, ballColor));
+
+    RasterPaint paddle = MakePaint(format, paddleColor);
+    FillQuad(target, positions + 24, paddle); // player 2
+    FillQuad(target, positions, paddle); // player 1
+}
+
+void RasterizeBatch(JobSystem& jobs, const std::vector<MatchState>& matches, int width, int height, RasterFormat format, unsigned char* pixels) {
+    const size_t frameBytes = RasterFrameBytes(width, height, format);
+
+    // a frame is a few microseconds of work, so hand them out in groups to keep the threads off the shared counter
+    jobs.ParallelFor(matches.size(), 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            RasterizeMatch(matches[i].positions, width, height, format, pixels + i * frameBytes);
+    });
+}
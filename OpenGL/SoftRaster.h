@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "Match.h"
+
+class JobSystem;
+
+// draws the scene on the cpu for agents that learn from pixels
+// at observation sizes a gl context costs far more than the few spans the scene is made of
+
+enum RasterFormat {
+    RASTER_GRAY, // one byte per pixel, bt.601 luma of the scene colors
+    RASTER_RGB // three bytes per pixel
+};
+
+inline size_t RasterFrameBytes(int width, int height, RasterFormat format) {
+    return (size_t)width * height * (format == RASTER_RGB ? 3 : 1);
+}
+
+// draws one match into pixels, rows top to bottom
+// pixels are covered by the same center sampling gl uses so the frames match the window
+void RasterizeMatch(const float* positions, int width, int height, RasterFormat format, unsigned char* pixels);
+
+// draws every match into its own frame, frame i starts at pixels + i * RasterFrameBytes
+// the matches are split between the job system's threads
+void RasterizeBatch(JobSystem& jobs, const std::vector<MatchState>& matches, int width, int height, RasterFormat format, unsigned char* pixels);
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// wait-free ring buffer for exactly one producer thread and one consumer thread
+// capacity has to be a power of two so the indices can just keep counting up
+template <typename T, size_t Capacity>
+class SpscQueue {
+public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+
+    SpscQueue()
+        : m_Head(0), m_Tail(0), m_CachedTail(0), m_CachedHead(0) {}
+
+    // producer side, returns false instead of waiting when the queue is full
+    bool Push(const T& value) {
+        size_t tail = m_Tail.load(std::memory_order_relaxed);
+        if (tail - m_CachedHead == Capacity) {
+            m_CachedHead = m_Head.load(std::memory_order_acquire);
+            if (tail - m_CachedHead == Capacity)
+                return false;
+        }
+        m_Items[tail & (Capacity - 1)] = value;
+        m_Tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumer side, returns nullptr when there is nothing to read
+    const T* Peek() {
+        size_t head = m_Head.load(std::memory_order_relaxed);
+        if (head == m_CachedTail) {
+            m_CachedTail = m_Tail.load(std::memory_order_acquire);
+            if (head == m_CachedTail)
+                return nullptr;
+        }
+        return &m_Items[head & (Capacity - 1)];
+    }
+
+    // only call after Peek returned something
+    void Pop() {
+        m_Head.store(m_Head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    T m_Items[Capacity];
+    alignas(64) std::atomic<size_t> m_Head; // next slot to read, written by the consumer
+    alignas(64) std::atomic<size_t> m_Tail; // next slot to write, written by the producer
+    alignas(64) size_t m_CachedTail; // consumer's copy of the tail
+    alignas(64) size_t m_CachedHead; // producer's copy of the head
+};
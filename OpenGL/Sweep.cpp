@@ -0,0 +1,282 @@
+#include "Sweep.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "Batch.h"
+#include "JobSystem.h"
+#include "Policies.h"
+
+const size_t sweepBatch = 64; // matches of one point handed to a thread at once
+
+void InitHistogram(Histogram& histogram, double low, double high, unsigned int bins) {
+    histogram.low = low;
+    histogram.high = high;
+    histogram.counts.assign(bins, 0);
+    histogram.under = 0;
+    histogram.over = 0;
+}
+
+void AddSample(Histogram& histogram, double value) {
+    if (value < histogram.low) {
+        histogram.under++;
+        return;
+    }
+    size_t bin = (size_t)((value - histogram.low) / (histogram.high - histogram.low) * histogram.counts.size());
+    if (bin >= histogram.counts.size())
+        histogram.over++;
+    else
+        histogram.counts[bin]++;
+}
+
+void MergeHistogram(Histogram& to, const Histogram& from) {
+    for (size_t i = 0; i < to.counts.size(); i++)
+        to.counts[i] += from.counts[i];
+    to.under += from.under;
+    to.over += from.over;
+}
+
+// splits text at every separator, false if any piece isn't a number
+static bool ParseFloats(const std::string& text, char separator, std::vector<float>& values) {
+    size_t begin = 0;
+    for (;;) {
+        size_t end = text.find(separator, begin);
+        std::string item = text.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+        char* parsed;
+        values.push_back(strtof(item.c_str(), &parsed));
+        if (item.empty() || *parsed != '\0')
+            return false;
+        if (end == std::string::npos)
+            return true;
+        begin = end + 1;
+    }
+}
+
+bool ParseSweepValues(const char* text, std::vector<float>& values) {
+    values.clear();
+    if (!strchr(text, ':'))
+        return ParseFloats(text, ',', values);
+
+    std::vector<float> range;
+    if (!ParseFloats(text, ':', range) || range.size() != 3 || range[2] < 1.0f || range[2] != std::floor(range[2]))
+        return false;
+    const unsigned int count = (unsigned int)range[2];
+    for (unsigned int i = 0; i < count; i++)
+        values.push_back(count == 1 ? range[0] : range[0] + (range[1] - range[0]) * i / (count - 1));
+    return true;
+}
+
+std::vector<MatchRules> SweepPoints(const SweepGrid& grid) {
+    const MatchRules classic;
+    const std::vector<float> speedInc = grid.speedInc.empty() ? std::vector<float>{ classic.speedInc } : grid.speedInc;
+    const std::vector<float> variance = grid.variance.empty() ? std::vector<float>{ classic.variance } : grid.variance;
+    const std::vector<float> ballSize = grid.ballSize.empty() ? std::vector<float>{ classic.ballSize } : grid.ballSize;
+    const std::vector<float> paddleLength = grid.paddleLength.empty() ? std::vector<float>{ classic.paddleLength } : grid.paddleLength;
+
+    std::vector<MatchRules> points;
+    for (float s : speedInc) {
+        for (float v : variance) {
+            for (float b : ballSize) {
+                for (float p : paddleLength) {
+                    MatchRules rules;
+                    rules.speedInc = s;
+                    rules.variance = v;
+                    rules.ballSize = b;
+                    rules.paddleLength = p;
+                    points.push_back(rules);
+                }
+            }
+        }
+    }
+    return points;
+}
+
+static void InitStats(SweepStats& stats, const SweepOptions& options) {
+    stats.matches = stats.leftWins = stats.draws = stats.rightWins = 0;
+    stats.rallies = stats.rallyTicks = stats.speedSum = 0;
+    InitHistogram(stats.rallyLength, 0.0, options.maxRally, options.bins);
+    InitHistogram(stats.finalSpeed, 0.0, options.maxSpeed, options.bins);
+}
+
+static void MergeStats(SweepStats& to, const SweepStats& from) {
+    to.matches += from.matches;
+    to.leftWins += from.leftWins;
+    to.draws += from.draws;
+    to.rightWins += from.rightWins;
+    to.rallies += from.rallies;
+    to.rallyTicks += from.rallyTicks;
+    to.speedSum += from.speedSum;
+    MergeHistogram(to.rallyLength, from.rallyLength);
+    MergeHistogram(to.finalSpeed, from.finalSpeed);
+}
+
+// one match at a time, watching the score so every rally gets measured as it ends
+template <typename LeftPolicy, typename RightPolicy>
+static void PlayPoint(const MatchRules& rules, const SweepOptions& options, size_t first, size_t count, SweepStats& stats) {
+    for (size_t m = first; m < first + count; m++) {
+        Match<LeftPolicy, RightPolicy> match;
+        MatchState& state = match.state;
+        InitMatch(state, BatchSeed(options.seed, m), rules);
+
+        while (!MatchOver(state) && state.ticks < options.maxTicks) {
+            const unsigned int timer = state.timer;
+            const float speed = state.ballSpeed;
+            const unsigned int points = state.score[0] + state.score[1];
+            TickMatch(match);
+
+            if (state.score[0] + state.score[1] != points) {
+                const unsigned int moving = timer > 100 ? timer - 100 : 0; // the ball waits 100 ticks to be served
+                stats.rallies++;
+                stats.rallyTicks += moving;
+                stats.speedSum += (unsigned long long)std::llround(speed * 1e9);
+                AddSample(stats.rallyLength, moving);
+                AddSample(stats.finalSpeed, speed);
+            }
+        }
+
+        stats.matches++;
+        if (state.score[0] > state.score[1])
+            stats.leftWins++;
+        else if (state.score[0] < state.score[1])
+            stats.rightWins++;
+        else
+            stats.draws++;
+    }
+}
+
+template <typename LeftPolicy>
+static void PlayPointAgainst(PolicyKind right, const MatchRules& rules, const SweepOptions& options, size_t first, size_t count, SweepStats& stats) {
+    switch (right) {
+    case POLICY_IDLE:
+        PlayPoint<LeftPolicy, HumanPolicy>(rules, options, first, count, stats);
+        break;
+    case POLICY_PREDICTIVE:
+        PlayPoint<LeftPolicy, PredictivePolicy>(rules, options, first, count, stats);
+        break;
+    default:
+        PlayPoint<LeftPolicy, TrackingPolicy>(rules, options, first, count, stats);
+        break;
+    }
+}
+
+// a run of matches at one point
+struct SweepRun {
+    unsigned int point;
+    size_t first; // seed index of the first match
+    size_t count;
+};
+
+std::vector<SweepStats> RunSweep(const std::vector<MatchRules>& points, const SweepOptions& options, JobSystem& jobs) {
+    // every point plays the same seeds so differences between points come from the rules
+    std::vector<SweepRun> runs;
+    for (unsigned int p = 0; p < points.size(); p++) {
+        for (size_t m = 0; m < options.matches; m += sweepBatch)
+            runs.push_back({ p, m, std::min(sweepBatch, options.matches - m) });
+    }
+
+    // each thread only ever touches its own stats, so there's nothing to lock until they're merged
+    std::vector<std::vector<SweepStats>> perThread(jobs.ThreadCount(), std::vector<SweepStats>(points.size()));
+    for (std::vector<SweepStats>& stats : perThread) {
+        for (SweepStats& point : stats)
+            InitStats(point, options);
+    }
+
+    jobs.ParallelFor(runs.size(), 1, [&](size_t begin, size_t end) {
+        std::vector<SweepStats>& stats = perThread[JobSystem::ThreadIndex()];
+        for (size_t r = begin; r < end; r++) {
+            const SweepRun& run = runs[r];
+            SweepStats& point = stats[run.point];
+            switch (options.left) {
+            case POLICY_IDLE:
+                PlayPointAgainst<HumanPolicy>(options.right, points[run.point], options, run.first, run.count, point);
+                break;
+            case POLICY_PREDICTIVE:
+                PlayPointAgainst<PredictivePolicy>(options.right, points[run.point], options, run.first, run.count, point);
+                break;
+            default:
+                PlayPointAgainst<TrackingPolicy>(options.right, points[run.point], options, run.first, run.count, point);
+                break;
+            }
+        }
+    });
+
+    std::vector<SweepStats> merged(points.size());
+    for (size_t p = 0; p < points.size(); p++) {
+        InitStats(merged[p], options);
+        for (const std::vector<SweepStats>& stats : perThread)
+            MergeStats(merged[p], stats[p]);
+    }
+    return merged;
+}
+
+static double Ratio(unsigned long long part, unsigned long long whole) {
+    return whole ? (double)part / whole : 0.0;
+}
+
+static double BinLow(const Histogram& histogram, size_t bin) {
+    return histogram.low + (histogram.high - histogram.low) * bin / histogram.counts.size();
+}
+
+void WriteSweepCsv(std::ostream& out, const std::vector<MatchRules>& points, const std::vector<SweepStats>& stats) {
+    out << "speed_inc,variance,ball_size,paddle_length,matches,left_wins,draws,right_wins,left_win_rate,rallies,mean_rally,mean_final_speed";
+    if (!stats.empty()) {
+        for (size_t b = 0; b < stats[0].rallyLength.counts.size(); b++)
+            out << ",rally_" << BinLow(stats[0].rallyLength, b);
+        out << ",rally_over";
+        for (size_t b = 0; b < stats[0].finalSpeed.counts.size(); b++)
+            out << ",speed_" << BinLow(stats[0].finalSpeed, b);
+        out << ",speed_over";
+    }
+    out << "\n";
+
+    for (size_t p = 0; p < points.size(); p++) {
+        const MatchRules& rules = points[p];
+        const SweepStats& s = stats[p];
+        out << rules.speedInc << "," << rules.variance << "," << rules.ballSize << "," << rules.paddleLength
+            << "," << s.matches << "," << s.leftWins << "," << s.draws << "," << s.rightWins << "," << Ratio(s.leftWins, s.matches)
+            << "," << s.rallies << "," << Ratio(s.rallyTicks, s.rallies) << "," << Ratio(s.speedSum, s.rallies) / 1e9;
+        for (unsigned long long count : s.rallyLength.counts)
+            out << "," << count;
+        out << "," << s.rallyLength.over;
+        for (unsigned long long count : s.finalSpeed.counts)
+            out << "," << count;
+        out << "," << s.finalSpeed.over << "\n";
+    }
+}
+
+static void WriteHistogramJson(std::ostream& out, const Histogram& histogram) {
+    out << "{\"low\": " << histogram.low << ", \"high\": " << histogram.high << ", \"under\": " << histogram.under
+        << ", \"over\": " << histogram.over << ", \"counts\": [";
+    for (size_t b = 0; b < histogram.counts.size(); b++)
+        out << (b ? ", " : "") << histogram.counts[b];
+    out << "]}";
+}
+
+void WriteSweepJson(std::ostream& out, const std::vector<MatchRules>& points, const std::vector<SweepStats>& stats) {
+    out << "{\n  \"points\": [";
+    for (size_t p = 0; p < points.size(); p++) {
+        const MatchRules& rules = points[p];
+        const SweepStats& s = stats[p];
+        out << (p ? "," : "") << "\n    {\"speed_inc\": " << rules.speedInc
+            << ", \"variance\": " << rules.variance
+            << ", \"ball_size\": " << rules.ballSize
+            << ", \"paddle_length\": " << rules.paddleLength
+            << ", \"matches\": " << s.matches
+            << ", \"left_wins\": " << s.leftWins
+            << ", \"draws\": " << s.draws
+            << ", \"right_wins\": " << s.rightWins
+            << ", \"left_win_rate\": " << Ratio(s.leftWins, s.matches)
+            << ", \"rallies\": " << s.rallies
+            << ", \"mean_rally\": " << Ratio(s.rallyTicks, s.rallies)
+            << ", \"mean_final_speed\": " << Ratio(s.speedSum, s.rallies) / 1e9
+            << ",\n     \"rally_length\": ";
+        WriteHistogramJson(out, s.rallyLength);
+        out << ",\n     \"final_speed\": ";
+        WriteHistogramJson(out, s.finalSpeed);
+        out << "}";
+    }
+    out << "\n  ]\n}\n";
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <vector>
+#include <ostream>
+
+#include "Match.h"
+#include "Tournament.h"
+
+class JobSystem;
+
+// monte carlo sweeps over MatchRules, the same seeded matches played at every point of a grid and reduced to histograms
+
+// fixed width bins from low to high, anything outside is only counted
+struct Histogram {
+    double low;
+    double high;
+    std::vector<unsigned long long> counts;
+    unsigned long long under;
+    unsigned long long over;
+};
+
+void InitHistogram(Histogram& histogram, double low, double high, unsigned int bins);
+void AddSample(Histogram& histogram, double value);
+void MergeHistogram(Histogram& to, const Histogram& from);
+
+// everything kept about a grid point, all counts so merging threads' stats in any order gives the same totals
+struct SweepStats {
+    unsigned long long matches;
+    unsigned long long leftWins;
+    unsigned long long draws; // level when the match ran out of ticks
+    unsigned long long rightWins;
+
+    unsigned long long rallies; // points played
+    unsigned long long rallyTicks; // ticks the ball was moving, over every rally
+    unsigned long long speedSum; // the ball's speed when each point was scored, in billionths
+
+    Histogram rallyLength; // ticks the ball was moving before a point
+    Histogram finalSpeed; // ball speed when a point was scored
+};
+
+// a list of values for each rule, every combination is a point
+struct SweepGrid {
+    std::vector<float> speedInc;
+    std::vector<float> variance;
+    std::vector<float> ballSize;
+    std::vector<float> paddleLength;
+};
+
+// "a,b,c" or "low:high:count" for count evenly spaced values from low to high
+bool ParseSweepValues(const char* text, std::vector<float>& values);
+
+// an empty list keeps the classic rule, paddle length changes fastest
+std::vector<MatchRules> SweepPoints(const SweepGrid& grid);
+
+struct SweepOptions {
+    unsigned int matches = 1000; // per point
+    unsigned int maxTicks = 20000; // bots that never miss would otherwise play maxMatchTicks every time
+    unsigned int seed = 1;
+    PolicyKind left = POLICY_TRACKING; // idle, tracking or predictive
+    PolicyKind right = POLICY_TRACKING;
+
+    unsigned int bins = 50;
+    double maxRally = 20000.0; // ticks, as long as a match can go by default
+    double maxSpeed = 0.05;
+};
+
+// plays every point's matches over jobs, each thread reduces into its own stats and they're merged at the end
+std::vector<SweepStats> RunSweep(const std::vector<MatchRules>& points, const SweepOptions& options, JobSystem& jobs);
+
+// one row per point, the histogram bins as columns named after their low edge
+void WriteSweepCsv(std::ostream& out, const std::vector<MatchRules>& points, const std::vector<SweepStats>& stats);
+void WriteSweepJson(std::ostream& out, const std::vector<MatchRules>& points, const std::vector<SweepStats>& stats);
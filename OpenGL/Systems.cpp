@@ -0,0 +1,187 @@
+#include "Systems.h"
+
+#include <cmath>
+
+#include "Match.h"
+#include "Collision.h"
+
+Entity SpawnPaddle(EntityStore& store, float x) {
+    Entity paddle = CreateEntity(store, x, 0.0f);
+    SetBoxCollider(store, paddle, paddleHalfWidth, paddleHalfHeight);
+    SetColor(store, paddle, 0, 140, 255);
+    return paddle;
+}
+
+Entity SpawnBall(EntityStore& store, float x, float y, float angle, float speed) {
+    Entity ball = CreateEntity(store, x, y);
+    unsigned int slot = EntitySlot(store, ball);
+    store.vx[slot] = std::cos(angle) * speed;
+    store.vy[slot] = std::sin(angle) * speed;
+    SetCircleCollider(store, ball, size);
+    return ball;
+}
+
+// reflects a circle off a contact's normal if it's heading into the box, and speeds it up
+static bool Reflect(EntityStore& store, unsigned int circle, const BoxContact& contact, float speedInc, float maxSpeed) {
+    // reflect where the circle is round, like BounceCircles
+    float vx = store.vx[circle];
+    float vy = store.vy[circle] / worldAspect;
+    float along = vx * contact.normalX + vy * contact.normalY;
+    if (along >= 0.0f) // already moving away
+        return false;
+
+    float speed = std::sqrt(store.vx[circle] * store.vx[circle] + store.vy[circle] * store.vy[circle]);
+    float faster = speed + speedInc < maxSpeed ? speed + speedInc : maxSpeed;
+    float scale = speed > 0.0f && faster > speed ? faster / speed : 1.0f;
+    store.vx[circle] = (vx - 2.0f * along * contact.normalX) * scale;
+    store.vy[circle] = (vy - 2.0f * along * contact.normalY) * worldAspect * scale;
+    return true;
+}
+
+bool BounceOffBox(EntityStore& store, unsigned int circle, unsigned int box, float speedInc, float maxSpeed) {
+    BoxContact contact;
+    if (!CircleBoxContact(store.x[circle], store.y[circle], store.halfWidth[circle], store.x[box], store.y[box], store.halfWidth[box], store.halfHeight[box], contact))
+        return false;
+    return Reflect(store, circle, contact, speedInc, maxSpeed);
+}
+
+bool BounceCircles(EntityStore& store, unsigned int a, unsigned int b) {
+    if (!CircleCircleOverlap(store.x[a], store.y[a], store.halfWidth[a], store.x[b], store.y[b], store.halfWidth[b]))
+        return false;
+
+    // work where the circles are round, then stretch y back
+    float nx = store.x[b] - store.x[a];
+    float ny = (store.y[b] - store.y[a]) / worldAspect;
+    float length = std::sqrt(nx * nx + ny * ny);
+    if (length == 0.0f)
+        return false;
+    nx /= length;
+    ny /= length;
+
+    float rvx = store.vx[b] - store.vx[a];
+    float rvy = (store.vy[b] - store.vy[a]) / worldAspect;
+    float closing = rvx * nx + rvy * ny;
+    if (closing >= 0.0f) // already moving apart
+        return false;
+
+    store.vx[a] += closing * nx;
+    store.vy[a] += closing * ny * worldAspect;
+    store.vx[b] -= closing * nx;
+    store.vy[b] -= closing * ny * worldAspect;
+    return true;
+}
+
+void IntegrateSystem(EntityStore& store) {
+    const size_t count = EntityCount(store);
+    float* x = store.x.data();
+    float* y = store.y.data();
+    const float* vx = store.vx.data();
+    const float* vy = store.vy.data();
+
+    for (size_t i = 0; i < count; i++) {
+        x[i] += vx[i];
+        y[i] += vy[i];
+    }
+}
+
+void WallSystem(EntityStore& store) {
+    const size_t count = EntityCount(store);
+    const unsigned char* shape = store.shape.data();
+    const float* halfHeight = store.halfHeight.data();
+    float* y = store.y.data();
+    float* vy = store.vy.data();
+
+    for (size_t i = 0; i < count; i++) {
+        float top = y[i] + halfHeight[i];
+        float bottom = y[i] - halfHeight[i];
+
+        if (shape[i] == COLLIDER_CIRCLE) {
+            // only flip when heading further out, so a ball that's still past the edge next tick doesn't flip back
+            if ((top > 1.0f && vy[i] > 0.0f) || (bottom < -1.0f && vy[i] < 0.0f))
+                vy[i] = -vy[i];
+        }
+        else if (shape[i] == COLLIDER_BOX) {
+            if (top > 1.0f)
+                y[i] = 1.0f - halfHeight[i];
+            if (bottom < -1.0f)
+                y[i] = -1.0f + halfHeight[i];
+        }
+    }
+}
+
+unsigned int PaddleSystem(EntityStore& store, float speedInc, PaddleScratch& scratch) {
+    const size_t count = EntityCount(store);
+
+    // boxes are few, gather them once and test every entity against them in one batch
+    scratch.boxX.clear();
+    scratch.boxY.clear();
+    scratch.boxHalfWidth.clear();
+    scratch.boxHalfHeight.clear();
+    for (size_t i = 0; i < count; i++) {
+        if (store.shape[i] != COLLIDER_BOX)
+            continue;
+        scratch.boxX.push_back(store.x[i]);
+        scratch.boxY.push_back(store.y[i]);
+        scratch.boxHalfWidth.push_back(store.halfWidth[i]);
+        scratch.boxHalfHeight.push_back(store.halfHeight[i]);
+    }
+
+    // boxes get tested as circles too, it's cheaper than gathering the circles and their contacts are skipped below
+    std::vector<BoxContact>& contacts = scratch.contacts;
+    contacts.clear();
+    CollideCirclesBoxes({ store.x.data(), store.y.data(), store.halfWidth.data(), count },
+        { scratch.boxX.data(), scratch.boxY.data(), scratch.boxHalfWidth.data(), scratch.boxHalfHeight.data(), scratch.boxX.size() }, contacts);
+
+    unsigned int hits = 0;
+    for (const BoxContact& contact : contacts) {
+        if (store.shape[contact.circle] == COLLIDER_CIRCLE && Reflect(store, contact.circle, contact, speedInc, 1e30f))
+            hits++;
+    }
+    return hits;
+}
+
+void OutOfBoundsSystem(const EntityStore& store, std::vector<Entity> out[2]) {
+    out[0].clear();
+    out[1].clear();
+
+    const size_t count = EntityCount(store);
+    for (size_t i = 0; i < count; i++) {
+        if (store.shape[i] != COLLIDER_CIRCLE)
+            continue;
+        if (store.x[i] - store.halfWidth[i] > 1.0f)
+            out[0].push_back(store.entities[i]);
+        else if (store.x[i] + store.halfWidth[i] < -1.0f)
+            out[1].push_back(store.entities[i]);
+    }
+}
+
+void TrackSystem(EntityStore& store, Entity paddle) {
+    const unsigned int p = EntitySlot(store, paddle);
+    const float px = store.x[p];
+    const size_t count = EntityCount(store);
+
+    // the closest ball on this paddle's half that's coming towards it
+    float nearest = 1e30f;
+    float targetY = 0.0f;
+    bool found = false;
+    for (size_t i = 0; i < count; i++) {
+        if (store.shape[i] != COLLIDER_CIRCLE)
+            continue;
+        if ((store.x[i] > 0.0f) != (px > 0.0f) || (store.vx[i] > 0.0f) != (px > store.x[i]))
+            continue;
+
+        float distance = std::fabs(px - store.x[i]);
+        if (distance < nearest) {
+            nearest = distance;
+            targetY = store.y[i];
+            found = true;
+        }
+    }
+
+    if (!found)
+        return;
+    if (store.y[p] > targetY)
+        store.y[p] -= paddleStepSize;
+    else if (store.y[p] < targetY)
+        store.y[p] += paddleStepSize;
+}
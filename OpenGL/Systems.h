@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include "EntityStore.h"
+#include "Collision.h"
+
+// systems run over every entity in the store, one component array at a time
+// entities that shouldn't be affected are left alone by their data (zero velocity, no collider) instead of by branches
+
+// same sizes and colors as the classic match
+const float paddleHalfWidth = 0.01f;
+const float paddleHalfHeight = 0.2f;
+const float paddleStepSize = 0.01f; // how far a bot moves a paddle each tick
+
+Entity SpawnPaddle(EntityStore& store, float x);
+
+// angle and speed like MatchState's ballAngle and ballSpeed
+Entity SpawnBall(EntityStore& store, float x, float y, float angle, float speed);
+
+// true if two circles touch, in the space where they're round
+inline bool CircleCircleOverlap(float ax, float ay, float aRadius, float bx, float by, float bRadius) {
+    float dx = bx - ax;
+    float dy = (by - ay) / worldAspect;
+    float reach = aRadius + bRadius;
+    return dx * dx + dy * dy < reach * reach;
+}
+
+// narrowphase and response for one pair, both return true if they bounced
+// a circle moving into a box is reflected off the side it hit and speeds up by speedInc, up to maxSpeed
+bool BounceOffBox(EntityStore& store, unsigned int circle, unsigned int box, float speedInc, float maxSpeed);
+
+// two touching circles moving towards each other swap their velocity along the line between them, like equal masses
+bool BounceCircles(EntityStore& store, unsigned int a, unsigned int b);
+
+// adds velocity to position
+void IntegrateSystem(EntityStore& store);
+
+// circles bounce off the top and bottom of the screen, boxes get pushed back onto it
+void WallSystem(EntityStore& store);
+
+// what PaddleSystem gathers the boxes and contacts into, kept by the caller so a tick doesn't allocate
+// the arrays grow to the most boxes and contacts seen and are never shrunk
+struct PaddleScratch {
+    std::vector<float> boxX;
+    std::vector<float> boxY;
+    std::vector<float> boxHalfWidth;
+    std::vector<float> boxHalfHeight;
+    std::vector<BoxContact> contacts;
+};
+
+// every circle against every box with the batch collision kernel, then the same response as BounceOffBox
+// returns how many bounces there were
+unsigned int PaddleSystem(EntityStore& store, float speedInc, PaddleScratch& scratch);
+
+// circles fully past the left or right edge, out[0] gets the ones past the right (a point for the left side)
+void OutOfBoundsSystem(const EntityStore& store, std::vector<Entity> out[2]);
+
+// moves a paddle a step towards the nearest circle heading at it, like the classic bot
+void TrackSystem(EntityStore& store, Entity paddle);
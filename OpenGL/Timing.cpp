@@ -0,0 +1,84 @@
+#include "Timing.h"
+
+#include <iostream>
+#include <algorithm>
+#include <thread>
+
+double Now() {
+    static const Clock::time_point epoch = Clock::now();
+    return std::chrono::duration<double>(Clock::now() - epoch).count();
+}
+
+void SleepUntil(double time) {
+    const double spin = 0.002; // how close to wake up before spinning
+
+    double now = Now();
+    while (time - now > spin) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        now = Now();
+    }
+    while (Now() < time)
+        std::this_thread::yield();
+}
+
+StageTrace::StageTrace(const char* name, size_t capacity)
+    : m_Name(name), m_Intervals(capacity), m_Count(0), m_Begin(0.0) {}
+
+void StageTrace::Begin() {
+    m_Begin = Now();
+}
+
+void StageTrace::End() {
+    m_Intervals[m_Count % m_Intervals.size()] = { m_Begin, Now() };
+    m_Count++;
+}
+
+// copies the ring out oldest first
+static std::vector<StageTrace::Interval> Ordered(const std::vector<StageTrace::Interval>& ring, size_t count) {
+    std::vector<StageTrace::Interval> out;
+    size_t n = std::min(count, ring.size());
+    for (size_t i = count - n; i < count; i++) {
+        out.push_back(ring[i % ring.size()]);
+    }
+    return out;
+}
+
+void PrintOverlap(const StageTrace& a, const StageTrace& b) {
+    std::vector<StageTrace::Interval> x = Ordered(a.m_Intervals, a.m_Count);
+    std::vector<StageTrace::Interval> y = Ordered(b.m_Intervals, b.m_Count);
+    if (x.empty() || y.empty())
+        return;
+
+    // only compare the window both traces still cover
+    double from = std::max(x.front().begin, y.front().begin);
+    double to = std::min(x.back().end, y.back().end);
+    if (to <= from)
+        return;
+
+    double busyA = 0.0, busyB = 0.0, overlap = 0.0;
+    for (const StageTrace::Interval& i : x)
+        busyA += std::max(0.0, std::min(i.end, to) - std::max(i.begin, from));
+    for (const StageTrace::Interval& i : y)
+        busyB += std::max(0.0, std::min(i.end, to) - std::max(i.begin, from));
+
+    // both lists are sorted so one merge pass finds every intersection
+    size_t i = 0, j = 0;
+    while (i < x.size() && j < y.size()) {
+        double begin = std::max(std::max(x[i].begin, y[j].begin), from);
+        double end = std::min(std::min(x[i].end, y[j].end), to);
+        if (end > begin)
+            overlap += end - begin;
+        if (x[i].end < y[j].end)
+            i++;
+        else
+            j++;
+    }
+
+    double window = to - from;
+    std::cout << "[Timing] over " << window << "s" << std::endl;
+    std::cout << "  " << a.Name() << ": " << a.m_Count << " runs, " << (busyA / window * 100) << "% busy, "
+        << (busyA / x.size() * 1000) << "ms avg" << std::endl;
+    std::cout << "  " << b.Name() << ": " << b.m_Count << " runs, " << (busyB / window * 100) << "% busy, "
+        << (busyB / y.size() * 1000) << "ms avg" << std::endl;
+    std::cout << "  overlapped " << (overlap * 1000) << "ms (" << (overlap / window * 100) << "% of the window)" << std::endl;
+}
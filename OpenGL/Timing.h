@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <cstddef>
+
+typedef std::chrono::steady_clock Clock;
+
+// seconds since the first call, shared by every thread so traces line up
+double Now();
+
+// sleeps most of the way then spins the rest, os sleeps alone can overshoot by a few ms
+void SleepUntil(double time);
+
+// records when a stage was busy so the sim and render threads can be compared
+// each trace is only written by one thread, read them after that thread is joined
+class StageTrace {
+public:
+    explicit StageTrace(const char* name, size_t capacity = 1 << 16);
+
+    void Begin();
+    void End();
+
+    const char* Name() const { return m_Name; }
+
+    struct Interval {
+        double begin;
+        double end;
+    };
+
+private:
+
+    const char* m_Name;
+    std::vector<Interval> m_Intervals; // ring of the most recent intervals
+    size_t m_Count;
+    double m_Begin;
+
+    friend void PrintOverlap(const StageTrace& a, const StageTrace& b);
+};
+
+// prints how busy each stage was and how much of that time they ran at the same time
+void PrintOverlap(const StageTrace& a, const StageTrace& b);
@@ -0,0 +1,300 @@
+#include "Tournament.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <numeric>
+#include <iomanip>
+
+#include "Batch.h"
+#include "JobSystem.h"
+#include "NeuralPolicy.h"
+#include "Policies.h"
+#include "Timing.h"
+
+const size_t tournamentBatch = 64; // matches of a pairing handed to a thread at once, and batched through a network
+
+bool ParsePolicyKind(const char* name, PolicyKind& kind) {
+    if (strcmp(name, "idle") == 0)
+        kind = POLICY_IDLE;
+    else if (strcmp(name, "tracking") == 0)
+        kind = POLICY_TRACKING;
+    else if (strcmp(name, "predictive") == 0)
+        kind = POLICY_PREDICTIVE;
+    else
+        return false;
+    return true;
+}
+
+// only networks have anything to decide before a tick, everyone else works it out in Move
+template <typename MatchType, typename Policy>
+static void DecideSide(std::vector<MatchType>&, Policy MatchType::*, MatchSide, const Mlp*, NeuralBatch&) {
+}
+
+template <typename MatchType>
+static void DecideSide(std::vector<MatchType>& matches, NeuralPolicy MatchType::* policy, MatchSide side, const Mlp* mlp, NeuralBatch& batch) {
+    DecideNeural(matches, policy, side, *mlp, batch);
+}
+
+// tuned bots get their parameters before the first tick, the rest start out as they are
+template <typename Policy>
+static void SetUp(Policy&, const Entrant&) {
+}
+
+static void SetUp(TunedPolicy& policy, const Entrant& entrant) {
+    policy.params = *entrant.params;
+}
+
+template <typename LeftPolicy, typename RightPolicy>
+static void PlayMatches(const Entrant& left, const Entrant& right, unsigned int seed, size_t first, size_t count, PairingResult& result,
+    unsigned int maxTicks) {
+    typedef Match<LeftPolicy, RightPolicy> MatchType;
+    std::vector<MatchType> matches(count);
+    for (size_t i = 0; i < count; i++) {
+        InitMatch(matches[i].state, BatchSeed(seed, first + i));
+        SetUp(matches[i].left, left);
+        SetUp(matches[i].right, right);
+    }
+
+    NeuralBatch batch;
+    for (unsigned int tick = 0; tick < maxTicks; tick++) {
+        DecideSide(matches, &MatchType::left, SIDE_LEFT, left.mlp, batch);
+        DecideSide(matches, &MatchType::right, SIDE_RIGHT, right.mlp, batch);
+        if (TickBatch(matches) == 0)
+            break;
+    }
+
+    for (const MatchType& match : matches) {
+        const unsigned int* score = match.state.score;
+        if (score[0] > score[1])
+            result.leftWins++;
+        else if (score[0] < score[1])
+            result.rightWins++;
+        else
+            result.draws++;
+        result.leftPoints += score[0];
+        result.rightPoints += score[1];
+    }
+}
+
+// every pairing of kinds gets its own loop with both controllers inlined
+template <typename LeftPolicy>
+static void PlayAgainst(const Entrant& left, const Entrant& right, unsigned int seed, size_t first, size_t count, PairingResult& result,
+    unsigned int maxTicks) {
+    switch (right.kind) {
+    case POLICY_IDLE:
+        PlayMatches<LeftPolicy, HumanPolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    case POLICY_TRACKING:
+        PlayMatches<LeftPolicy, TrackingPolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    case POLICY_PREDICTIVE:
+        PlayMatches<LeftPolicy, PredictivePolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    case POLICY_NEURAL:
+        PlayMatches<LeftPolicy, NeuralPolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    case POLICY_TUNED:
+        PlayMatches<LeftPolicy, TunedPolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    }
+}
+
+void PlayPairing(const Entrant& left, const Entrant& right, unsigned int seed, size_t first, size_t count, PairingResult& result,
+    unsigned int maxTicks) {
+    switch (left.kind) {
+    case POLICY_IDLE:
+        PlayAgainst<HumanPolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    case POLICY_TRACKING:
+        PlayAgainst<TrackingPolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    case POLICY_PREDICTIVE:
+        PlayAgainst<PredictivePolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    case POLICY_NEURAL:
+        PlayAgainst<NeuralPolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    case POLICY_TUNED:
+        PlayAgainst<TunedPolicy>(left, right, seed, first, count, result, maxTicks);
+        break;
+    }
+}
+
+void AddResult(PairingResult& to, const PairingResult& from, bool swapped) {
+    to.leftWins += swapped ? from.rightWins : from.leftWins;
+    to.draws += from.draws;
+    to.rightWins += swapped ? from.leftWins : from.rightWins;
+    to.leftPoints += swapped ? from.rightPoints : from.leftPoints;
+    to.rightPoints += swapped ? from.leftPoints : from.rightPoints;
+}
+
+std::vector<Pairing> RoundRobinPairings(unsigned int entrants) {
+    std::vector<Pairing> pairings;
+    for (unsigned int a = 0; a < entrants; a++) {
+        for (unsigned int b = a + 1; b < entrants; b++)
+            pairings.push_back({ a, b });
+    }
+    return pairings;
+}
+
+// best rated first, ties go to whoever was entered first so the order never depends on the sort
+static std::vector<unsigned int> RatingOrder(const std::vector<Entrant>& entrants) {
+    std::vector<unsigned int> order(entrants.size());
+    std::iota(order.begin(), order.end(), 0u);
+    std::sort(order.begin(), order.end(), [&](unsigned int x, unsigned int y) {
+        if (entrants[x].rating != entrants[y].rating)
+            return entrants[x].rating > entrants[y].rating;
+        return x < y;
+    });
+    return order;
+}
+
+std::vector<Pairing> SwissPairings(const std::vector<Entrant>& entrants, const std::vector<bool>& played) {
+    const size_t count = entrants.size();
+    std::vector<unsigned int> order = RatingOrder(entrants);
+    std::vector<bool> paired(count, false);
+    std::vector<Pairing> pairings;
+
+    for (size_t i = 0; i < count; i++) {
+        const unsigned int a = order[i];
+        if (paired[a])
+            continue;
+
+        // the next one down that a hasn't met yet, or just the next one down once a has met everyone left
+        size_t pick = count;
+        for (size_t j = i + 1; j < count; j++) {
+            const unsigned int b = order[j];
+            if (paired[b])
+                continue;
+            if (pick == count)
+                pick = j;
+            if (!played[a * count + b]) {
+                pick = j;
+                break;
+            }
+        }
+        if (pick == count)
+            break; // a is the odd one out
+
+        paired[a] = paired[order[pick]] = true;
+        pairings.push_back({ a, order[pick] });
+    }
+    return pairings;
+}
+
+void UpdateRatings(std::vector<Entrant>& entrants, const std::vector<Pairing>& pairings, const std::vector<PairingResult>& results, double kFactor) {
+    std::vector<double> change(entrants.size(), 0.0);
+    for (size_t i = 0; i < pairings.size(); i++) {
+        Entrant& a = entrants[pairings[i].a];
+        Entrant& b = entrants[pairings[i].b];
+        const PairingResult& result = results[i];
+        const unsigned int played = result.leftWins + result.draws + result.rightWins;
+        if (played == 0)
+            continue;
+
+        a.wins += result.leftWins;
+        a.draws += result.draws;
+        a.losses += result.rightWins;
+        b.wins += result.rightWins;
+        b.draws += result.draws;
+        b.losses += result.leftWins;
+
+        double score = (result.leftWins + 0.5 * result.draws) / played;
+        double expected = 1.0 / (1.0 + std::pow(10.0, (b.rating - a.rating) / 400.0));
+        change[pairings[i].a] += kFactor * (score - expected);
+        change[pairings[i].b] -= kFactor * (score - expected);
+    }
+
+    for (size_t i = 0; i < entrants.size(); i++)
+        entrants[i].rating += change[i];
+}
+
+// a run of matches of one pairing with the same entrant on the left
+struct MatchRun {
+    unsigned int pairing;
+    bool swapped; // b is on the left
+    size_t first; // seed index of the first match
+    size_t count;
+};
+
+void RunTournament(std::vector<Entrant>& entrants, const TournamentOptions& options, JobSystem& jobs, std::ostream& progress) {
+    const unsigned int count = (unsigned int)entrants.size();
+    std::vector<bool> played(count * count, false);
+    std::mutex progressMutex; // only for the progress lines, results never wait on it
+    size_t nextSeed = 0;
+
+    // both halves of a pairing play the same seeds with the sides swapped, so neither gets the luckier serves
+    const size_t leftHalf = (options.matches + 1) / 2;
+    const size_t rightHalf = options.matches / 2;
+
+    for (unsigned int round = 0; round < options.rounds; round++) {
+        std::vector<Pairing> pairings = options.format == TOURNAMENT_SWISS ? SwissPairings(entrants, played) : RoundRobinPairings(count);
+
+        std::vector<MatchRun> runs;
+        for (unsigned int p = 0; p < pairings.size(); p++) {
+            for (size_t i = 0; i < leftHalf; i += tournamentBatch)
+                runs.push_back({ p, false, nextSeed + i, std::min(tournamentBatch, leftHalf - i) });
+            for (size_t i = 0; i < rightHalf; i += tournamentBatch)
+                runs.push_back({ p, true, nextSeed + i, std::min(tournamentBatch, rightHalf - i) });
+            nextSeed += leftHalf;
+        }
+
+        // every thread counts into its own tallies, they're only added up once the round is over
+        std::vector<std::vector<PairingResult>> tallies(jobs.ThreadCount(), std::vector<PairingResult>(pairings.size()));
+        const size_t total = pairings.size() * options.matches;
+        std::atomic<size_t> done(0);
+        double begin = Now();
+
+        jobs.ParallelFor(runs.size(), 1, [&](size_t first, size_t last) {
+            std::vector<PairingResult>& tally = tallies[JobSystem::ThreadIndex()];
+            for (size_t r = first; r < last; r++) {
+                const MatchRun& run = runs[r];
+                const Pairing& pairing = pairings[run.pairing];
+                PairingResult result;
+                if (run.swapped)
+                    PlayPairing(entrants[pairing.b], entrants[pairing.a], options.seed, run.first, run.count, result);
+                else
+                    PlayPairing(entrants[pairing.a], entrants[pairing.b], options.seed, run.first, run.count, result);
+                AddResult(tally[run.pairing], result, run.swapped);
+
+                // a line every tenth of the round
+                size_t before = done.fetch_add(run.count);
+                size_t after = before + run.count;
+                if (before * 10 / total != after * 10 / total) {
+                    std::lock_guard<std::mutex> lock(progressMutex);
+                    progress << "[Tournament] round " << round + 1 << "/" << options.rounds << " "
+                        << after * 100 / total << "% (" << after << "/" << total << " matches)" << std::endl;
+                }
+            }
+        });
+
+        std::vector<PairingResult> results(pairings.size());
+        for (const std::vector<PairingResult>& tally : tallies) {
+            for (size_t p = 0; p < pairings.size(); p++)
+                AddResult(results[p], tally[p]);
+        }
+        UpdateRatings(entrants, pairings, results, options.kFactor);
+        for (const Pairing& pairing : pairings)
+            played[pairing.a * count + pairing.b] = played[pairing.b * count + pairing.a] = true;
+
+        double seconds = Now() - begin;
+        progress << "[Tournament] round " << round + 1 << " done, " << total << " matches in " << seconds << "s ("
+            << (seconds > 0.0 ? total / seconds : 0.0) << " matches/s on " << jobs.ThreadCount() << " threads)" << std::endl;
+        WriteStandings(progress, entrants);
+    }
+}
+
+void WriteStandings(std::ostream& out, const std::vector<Entrant>& entrants) {
+    std::vector<unsigned int> order = RatingOrder(entrants);
+    const std::streamsize precision = out.precision();
+    for (size_t i = 0; i < order.size(); i++) {
+        const Entrant& entrant = entrants[order[i]];
+        out << std::setw(3) << i + 1 << "  " << std::left << std::setw(24) << entrant.name << std::right
+            << std::setw(7) << std::fixed << std::setprecision(1) << entrant.rating << std::defaultfloat
+            << "  w " << entrant.wins << " d " << entrant.draws << " l " << entrant.losses << std::endl;
+    }
+    out.precision(precision);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstddef>
+
+#include "Mlp.h"
+#include "Policies.h"
+
+class JobSystem;
+
+// matches between paddle controllers, scheduled over a JobSystem and rated with elo
+
+enum PolicyKind {
+    POLICY_IDLE, // never moves
+    POLICY_TRACKING,
+    POLICY_PREDICTIVE,
+    POLICY_NEURAL, // needs an Mlp
+    POLICY_TUNED // needs BotParams
+};
+
+// "idle", "tracking" or "predictive", networks are loaded by the caller
+bool ParsePolicyKind(const char* name, PolicyKind& kind);
+
+struct Entrant {
+    std::string name;
+    PolicyKind kind;
+    const Mlp* mlp = nullptr; // only for POLICY_NEURAL, not owned
+    const BotParams* params = nullptr; // only for POLICY_TUNED, not owned
+
+    double rating = 1500.0;
+    unsigned int wins = 0;
+    unsigned int draws = 0;
+    unsigned int losses = 0;
+};
+
+// counted from the left paddle's side, a match that runs out of ticks level is a draw
+struct PairingResult {
+    unsigned int leftWins = 0;
+    unsigned int draws = 0;
+    unsigned int rightWins = 0;
+    unsigned int leftPoints = 0;
+    unsigned int rightPoints = 0;
+};
+
+// plays count matches of left against right, match i seeded with BatchSeed(seed, first + i)
+// the matches run as one batch so networks see them all at once
+// maxTicks cuts matches short and scores them as they stand, the default lets every match finish
+void PlayPairing(const Entrant& left, const Entrant& right, unsigned int seed, size_t first, size_t count, PairingResult& result,
+    unsigned int maxTicks = maxMatchTicks);
+
+// adds from to to, with from's sides swapped first when swapped is true
+void AddResult(PairingResult& to, const PairingResult& from, bool swapped = false);
+
+enum TournamentFormat {
+    TOURNAMENT_ROUND_ROBIN, // everyone plays everyone each round
+    TOURNAMENT_SWISS // each round pairs neighbours in the standings, avoiding rematches
+};
+
+struct TournamentOptions {
+    TournamentFormat format = TOURNAMENT_ROUND_ROBIN;
+    unsigned int rounds = 8;
+    unsigned int matches = 100; // per pairing per round, half with each entrant on the left
+    unsigned int seed = 1;
+    double kFactor = 32.0;
+};
+
+// two entrants that play each other in a round
+struct Pairing {
+    unsigned int a;
+    unsigned int b;
+};
+
+std::vector<Pairing> RoundRobinPairings(unsigned int entrants);
+
+// played is entrants by entrants, true where two have already met
+// with an odd number of entrants the lowest rated one without a match sits the round out
+std::vector<Pairing> SwissPairings(const std::vector<Entrant>& entrants, const std::vector<bool>& played);
+
+// results[i] is pairings[i]'s tally counted as if a had been on the left in every match
+// one elo update per pairing from its score over the round, with everyone's rating as it was before the round
+// a pairing's total score counts as a single result so a pairing of many matches moves a rating by at most kFactor
+void UpdateRatings(std::vector<Entrant>& entrants, const std::vector<Pairing>& pairings, const std::vector<PairingResult>& results, double kFactor);
+
+// runs every round and writes progress and the standings after each round to progress
+// the results are the same whatever the number of threads
+void RunTournament(std::vector<Entrant>& entrants, const TournamentOptions& options, JobSystem& jobs, std::ostream& progress);
+
+// entrants from best to worst rated
+void WriteStandings(std::ostream& out, const std::vector<Entrant>& entrants);
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+
+// lock-free triple buffer for one writer thread and one reader thread
+// the writer fills the back slot and swaps it with the middle one, the reader swaps
+// the middle slot with its front one when something new was published
+// neither side ever waits and the reader always sees the newest complete value
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer()
+        : m_Middle(1), m_Back(0), m_Front(2) {}
+
+    // writer side
+    T& Back() { return m_Buffers[m_Back]; }
+
+    void Publish() {
+        m_Back = m_Middle.exchange(m_Back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // reader side, returns true if a newer value was picked up
+    bool Update() {
+        if (!(m_Middle.load(std::memory_order_relaxed) & freshBit))
+            return false;
+        m_Front = m_Middle.exchange(m_Front, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const T& Front() const { return m_Buffers[m_Front]; }
+
+private:
+    static const unsigned int indexMask = 3;
+    static const unsigned int freshBit = 4;
+
+    T m_Buffers[3];
+    alignas(64) std::atomic<unsigned int> m_Middle;
+    alignas(64) unsigned int m_Back; // only touched by the writer
+    alignas(64) unsigned int m_Front; // only touched by the reader
+};
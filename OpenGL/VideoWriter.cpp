@@ -0,0 +1,109 @@
+#include "VideoWriter.h"
+
+#include <iostream>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+#include "Yuv.h"
+
+VideoWriter::VideoWriter(const char* path, int width, int height, int fps, unsigned int depth)
+    : m_File(nullptr), m_Width(width), m_Height(height), m_Frames(depth), m_FramesWritten(0) {
+    // the 4:2:0 conversion works on 2x2 blocks, an odd size would read and write past the frames
+    if (width <= 0 || height <= 0 || width % 2 != 0 || height % 2 != 0) {
+        std::cerr << "[Video] " << width << "x" << height << " can't be captured, the size has to be even and positive" << std::endl;
+        return;
+    }
+
+    if (strcmp(path, "-") == 0) {
+#ifdef _WIN32
+        _setmode(_fileno(stdout), _O_BINARY); // stop windows from turning \n into \r\n in the video
+#endif
+        m_File = stdout;
+    }
+    else {
+        m_File = fopen(path, "wb");
+    }
+
+    if (!m_File) {
+        std::cerr << "[Video] couldn't open " << path << std::endl;
+        return;
+    }
+
+    fprintf(m_File, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, fps);
+
+    m_Yuv.resize((size_t)width * height * 3 / 2);
+    for (std::vector<unsigned char>& frame : m_Frames) {
+        frame.resize((size_t)width * height * 4);
+        m_Free.Push(frame.data());
+    }
+
+    m_Thread = std::thread(&VideoWriter::Worker, this);
+}
+
+VideoWriter::~VideoWriter() {
+    if (!m_File)
+        return;
+
+    Submit(nullptr);
+    m_Thread.join();
+
+    fflush(m_File);
+    if (m_File != stdout)
+        fclose(m_File);
+}
+
+unsigned char* VideoWriter::Acquire() {
+    unsigned char* const* frame = m_Free.Peek();
+    if (!frame) {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Freed.wait(lock, [&]() { return (frame = m_Free.Peek()) != nullptr; });
+    }
+
+    unsigned char* out = *frame;
+    m_Free.Pop();
+    return out;
+}
+
+// taking the lock between the push and the notify means a waiter either sees the frame or is already asleep and gets woken
+static void Wake(std::mutex& mutex, std::condition_variable& waiter) {
+    { std::lock_guard<std::mutex> lock(mutex); }
+    waiter.notify_one();
+}
+
+void VideoWriter::Submit(unsigned char* frame) {
+    m_Full.Push(frame); // never full, there are fewer frames than slots
+    Wake(m_Mutex, m_Queued);
+}
+
+void VideoWriter::Worker() {
+    const size_t lumaSize = (size_t)m_Width * m_Height;
+    unsigned char* y = m_Yuv.data();
+    unsigned char* u = y + lumaSize;
+    unsigned char* v = u + lumaSize / 4;
+
+    for (;;) {
+        // sleeps while the render thread has nothing queued instead of spinning on a core for the whole capture
+        unsigned char* const* next = m_Full.Peek();
+        if (!next) {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Queued.wait(lock, [&]() { return (next = m_Full.Peek()) != nullptr; });
+        }
+        unsigned char* frame = *next;
+        m_Full.Pop();
+
+        if (!frame)
+            break;
+
+        RgbaToYuv420(frame, m_Width, m_Height, y, u, v);
+        m_Free.Push(frame);
+        Wake(m_Mutex, m_Freed);
+
+        fputs("FRAME\n", m_File);
+        fwrite(m_Yuv.data(), 1, m_Yuv.size(), m_File);
+        m_FramesWritten++;
+    }
+}
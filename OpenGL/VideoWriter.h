@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "SpscQueue.h"
+
+// streams frames as y4m to a file or stdout (for piping into an encoder)
+// the yuv conversion and writing happen on a worker thread so the render loop only copies pixels
+class VideoWriter {
+public:
+    // path "-" writes to stdout, depth is how many frames can be queued up
+    // width and height have to be even, otherwise nothing is opened and Valid is false
+    VideoWriter(const char* path, int width, int height, int fps, unsigned int depth = 4);
+    ~VideoWriter(); // writes out everything still queued
+
+    bool Valid() const { return m_File != nullptr; }
+
+    // a buffer for the next rgba frame, waits if the worker is behind
+    unsigned char* Acquire();
+
+    // hands a buffer from Acquire to the worker
+    void Submit(unsigned char* frame);
+
+    unsigned int FramesWritten() const { return m_FramesWritten; }
+
+private:
+    void Worker();
+
+    FILE* m_File;
+    int m_Width;
+    int m_Height;
+    std::vector<std::vector<unsigned char> > m_Frames;
+    std::vector<unsigned char> m_Yuv;
+
+    SpscQueue<unsigned char*, 64> m_Free; // worker to render thread
+    SpscQueue<unsigned char*, 64> m_Full; // render thread to worker, null means stop
+    std::mutex m_Mutex; // only held to sleep and wake, the queues don't need it
+    std::condition_variable m_Queued; // the worker waits here for a frame
+    std::condition_variable m_Freed; // Acquire waits here for a buffer
+    std::thread m_Thread;
+    unsigned int m_FramesWritten; // only read after the worker is joined
+};
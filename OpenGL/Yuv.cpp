@@ -0,0 +1,137 @@
+#include "Yuv.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define YUV_SSE2
+#include <emmintrin.h>
+#endif
+
+// one 2x2 block starting at column x of two rows
+static void ConvertBlock(const unsigned char* top, const unsigned char* bottom, int x,
+    unsigned char* y0, unsigned char* y1, unsigned char* u, unsigned char* v) {
+    int r = 0, g = 0, b = 0;
+    for (int i = 0; i < 2; i++) {
+        const unsigned char* p = top + (x + i) * 4;
+        const unsigned char* q = bottom + (x + i) * 4;
+        y0[x + i] = (unsigned char)(((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8) + 16);
+        y1[x + i] = (unsigned char)(((66 * q[0] + 129 * q[1] + 25 * q[2] + 128) >> 8) + 16);
+        r += p[0] + q[0];
+        g += p[1] + q[1];
+        b += p[2] + q[2];
+    }
+    u[x / 2] = (unsigned char)(((-38 * r - 74 * g + 112 * b + 512) >> 10) + 128);
+    v[x / 2] = (unsigned char)(((112 * r - 94 * g - 18 * b + 512) >> 10) + 128);
+}
+
+void RgbaToYuv420Scalar(const unsigned char* rgba, int width, int height, unsigned char* y, unsigned char* u, unsigned char* v) {
+    for (int row = 0; row < height; row += 2) {
+        // flip vertically on the way through
+        const unsigned char* top = rgba + (size_t)(height - 1 - row) * width * 4;
+        const unsigned char* bottom = top - (size_t)width * 4;
+        unsigned char* y0 = y + (size_t)row * width;
+        unsigned char* y1 = y0 + width;
+        unsigned char* uRow = u + (size_t)(row / 2) * (width / 2);
+        unsigned char* vRow = v + (size_t)(row / 2) * (width / 2);
+
+        for (int x = 0; x < width; x += 2)
+            ConvertBlock(top, bottom, x, y0, y1, uRow, vRow);
+    }
+}
+
+#ifdef YUV_SSE2
+
+// picks lanes 0 and 2 of a and b, the pair sums left behind by madd + shift
+static __m128i EvenLanes(__m128i a, __m128i b) {
+    return _mm_unpacklo_epi64(_mm_shuffle_epi32(a, _MM_SHUFFLE(3, 3, 2, 0)), _mm_shuffle_epi32(b, _MM_SHUFFLE(3, 3, 2, 0)));
+}
+
+// dot product of each pixel's 16 bit rgba with the coefficients, 4 pixels in two registers
+static __m128i Dot4(__m128i lo, __m128i hi, __m128i coefficients) {
+    __m128i a = _mm_madd_epi16(lo, coefficients);
+    __m128i b = _mm_madd_epi16(hi, coefficients);
+    a = _mm_add_epi32(a, _mm_srli_epi64(a, 32));
+    b = _mm_add_epi32(b, _mm_srli_epi64(b, 32));
+    return EvenLanes(a, b);
+}
+
+// 8 luma values from 8 rgba pixels
+static __m128i Luma8(__m128i p0, __m128i p1) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i coefficients = _mm_setr_epi16(66, 129, 25, 0, 66, 129, 25, 0);
+    const __m128i round = _mm_set1_epi32(128);
+    const __m128i offset = _mm_set1_epi16(16);
+
+    __m128i a = Dot4(_mm_unpacklo_epi8(p0, zero), _mm_unpackhi_epi8(p0, zero), coefficients);
+    __m128i b = Dot4(_mm_unpacklo_epi8(p1, zero), _mm_unpackhi_epi8(p1, zero), coefficients);
+    a = _mm_srai_epi32(_mm_add_epi32(a, round), 8);
+    b = _mm_srai_epi32(_mm_add_epi32(b, round), 8);
+    return _mm_add_epi16(_mm_packs_epi32(a, b), offset);
+}
+
+// sums each 2x2 block of 4 pixels from two rows, gives 2 blocks of 16 bit rgba
+static __m128i BlockSums(__m128i top, __m128i bottom) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+    __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+    lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+    hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+// 4 chroma values from the block sums of 8 columns
+static __m128i Chroma4(__m128i sums0, __m128i sums1, __m128i coefficients) {
+    const __m128i round = _mm_set1_epi32(512);
+    const __m128i offset = _mm_set1_epi32(128);
+    __m128i c = Dot4(sums0, sums1, coefficients);
+    return _mm_add_epi32(_mm_srai_epi32(_mm_add_epi32(c, round), 10), offset);
+}
+
+void RgbaToYuv420(const unsigned char* rgba, int width, int height, unsigned char* y, unsigned char* u, unsigned char* v) {
+    const __m128i uCoefficients = _mm_setr_epi16(-38, -74, 112, 0, -38, -74, 112, 0);
+    const __m128i vCoefficients = _mm_setr_epi16(112, -94, -18, 0, 112, -94, -18, 0);
+
+    for (int row = 0; row < height; row += 2) {
+        const unsigned char* top = rgba + (size_t)(height - 1 - row) * width * 4;
+        const unsigned char* bottom = top - (size_t)width * 4;
+        unsigned char* y0 = y + (size_t)row * width;
+        unsigned char* y1 = y0 + width;
+        unsigned char* uRow = u + (size_t)(row / 2) * (width / 2);
+        unsigned char* vRow = v + (size_t)(row / 2) * (width / 2);
+
+        int x = 0;
+        // 16 columns at a time, 16 luma per row and 8 chroma
+        for (; x + 16 <= width; x += 16) {
+            __m128i t0 = _mm_loadu_si128((const __m128i*)(top + x * 4));
+            __m128i t1 = _mm_loadu_si128((const __m128i*)(top + x * 4 + 16));
+            __m128i t2 = _mm_loadu_si128((const __m128i*)(top + x * 4 + 32));
+            __m128i t3 = _mm_loadu_si128((const __m128i*)(top + x * 4 + 48));
+            __m128i b0 = _mm_loadu_si128((const __m128i*)(bottom + x * 4));
+            __m128i b1 = _mm_loadu_si128((const __m128i*)(bottom + x * 4 + 16));
+            __m128i b2 = _mm_loadu_si128((const __m128i*)(bottom + x * 4 + 32));
+            __m128i b3 = _mm_loadu_si128((const __m128i*)(bottom + x * 4 + 48));
+
+            _mm_storeu_si128((__m128i*)(y0 + x), _mm_packus_epi16(Luma8(t0, t1), Luma8(t2, t3)));
+            _mm_storeu_si128((__m128i*)(y1 + x), _mm_packus_epi16(Luma8(b0, b1), Luma8(b2, b3)));
+
+            __m128i s0 = BlockSums(t0, b0);
+            __m128i s1 = BlockSums(t1, b1);
+            __m128i s2 = BlockSums(t2, b2);
+            __m128i s3 = BlockSums(t3, b3);
+
+            __m128i uValues = _mm_packs_epi32(Chroma4(s0, s1, uCoefficients), Chroma4(s2, s3, uCoefficients));
+            __m128i vValues = _mm_packs_epi32(Chroma4(s0, s1, vCoefficients), Chroma4(s2, s3, vCoefficients));
+            _mm_storel_epi64((__m128i*)(uRow + x / 2), _mm_packus_epi16(uValues, uValues));
+            _mm_storel_epi64((__m128i*)(vRow + x / 2), _mm_packus_epi16(vValues, vValues));
+        }
+
+        for (; x < width; x += 2)
+            ConvertBlock(top, bottom, x, y0, y1, uRow, vRow);
+    }
+}
+
+#else
+
+void RgbaToYuv420(const unsigned char* rgba, int width, int height, unsigned char* y, unsigned char* u, unsigned char* v) {
+    RgbaToYuv420Scalar(rgba, width, height, y, u, v);
+}
+
+#endif
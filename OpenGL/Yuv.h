@@ -0,0 +1,8 @@
+#pragma once
+
+// rgba (rows bottom to top, like glReadPixels gives them) to yuv 4:2:0 planes (rows top to bottom)
+// bt.601 limited range, chroma is the average of each 2x2 block, width and height have to be even
+void RgbaToYuv420(const unsigned char* rgba, int width, int height, unsigned char* y, unsigned char* u, unsigned char* v);
+
+// plain c++ version, the simd one has to give exactly the same bytes
+void RgbaToYuv420Scalar(const unsigned char* rgba, int width, int height, unsigned char* y, unsigned char* u, unsigned char* v);
@@ -0,0 +1,9 @@
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec4 v_Color;
+
+void main() {
+   color = v_Color;
+};
\ No newline at end of file
@@ -0,0 +1,13 @@
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec4 color;
+
+uniform vec2 u_Offset;
+
+out vec4 v_Color;
+
+void main() {
+   gl_Position = position + vec4(u_Offset, 0.0, 0.0);
+   v_Color = color;
+};
\ No newline at end of file
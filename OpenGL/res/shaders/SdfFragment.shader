@@ -0,0 +1,17 @@
+#version 330 core
+
+layout(location = 0) out vec4 color;
+
+in vec2 v_Local; // pixels from the center of the shape
+in vec3 v_Shape; // half width, half height and corner radius in pixels
+in vec4 v_Color;
+
+void main() {
+   // distance to a rounded rectangle, negative inside
+   vec2 q = abs(v_Local) - v_Shape.xy + v_Shape.z;
+   float d = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - v_Shape.z;
+
+   // d is in pixels so the edge fades over exactly one pixel
+   float coverage = clamp(0.5 - d, 0.0, 1.0);
+   color = vec4(v_Color.rgb, v_Color.a * coverage);
+};
\ No newline at end of file
@@ -0,0 +1,19 @@
+#version 330 core
+
+layout(location = 0) in vec4 position;
+layout(location = 1) in vec2 local;
+layout(location = 2) in vec3 shape;
+layout(location = 3) in vec4 color;
+
+uniform vec2 u_Offset;
+
+out vec2 v_Local;
+out vec3 v_Shape;
+out vec4 v_Color;
+
+void main() {
+   gl_Position = position + vec4(u_Offset, 0.0, 0.0);
+   v_Local = local;
+   v_Shape = shape;
+   v_Color = color;
+};
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 layout(location = 0) in vec4 position;
 
+uniform vec2 u_Offset;
+
 void main() {
-   gl_Position = position;
+   gl_Position = position + vec4(u_Offset, 0.0, 0.0);
 };
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+
+#include "JobSystem.h"
+#include "Sweep.h"
+#include "Timing.h"
+
+// plays seeded matches at every point of a grid of rules and writes histograms of how they went, e.g.
+//     Sweep --speed-inc 0.0001:0.0008:8 --variance 0,0.1,0.2 --matches 2000 --format json --out sweep.json
+static void PrintUsage() {
+    std::cout << "Usage: Sweep [--speed-inc values] [--variance values] [--ball-size values] [--paddle-length values] [--matches n] "
+        "[--ticks n] [--seed n] [--threads n] [--left policy] [--right policy] [--bins n] [--max-rally f] [--max-speed f] "
+        "[--format csv|json] [--out path]" << std::endl;
+    std::cout << "values are a,b,c or low:high:count, policies are idle, tracking or predictive" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    SweepGrid grid;
+    SweepOptions options;
+    unsigned int threads = 0;
+    bool json = false;
+    const char* outPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        bool ok = true;
+        if (strcmp(argv[i], "--speed-inc") == 0 && i + 1 < argc)
+            ok = ParseSweepValues(argv[++i], grid.speedInc);
+        else if (strcmp(argv[i], "--variance") == 0 && i + 1 < argc)
+            ok = ParseSweepValues(argv[++i], grid.variance);
+        else if (strcmp(argv[i], "--ball-size") == 0 && i + 1 < argc)
+            ok = ParseSweepValues(argv[++i], grid.ballSize);
+        else if (strcmp(argv[i], "--paddle-length") == 0 && i + 1 < argc)
+            ok = ParseSweepValues(argv[++i], grid.paddleLength);
+        else if (strcmp(argv[i], "--matches") == 0 && i + 1 < argc)
+            options.matches = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc)
+            options.maxTicks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            options.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--left") == 0 && i + 1 < argc)
+            ok = ParsePolicyKind(argv[++i], options.left);
+        else if (strcmp(argv[i], "--right") == 0 && i + 1 < argc)
+            ok = ParsePolicyKind(argv[++i], options.right);
+        else if (strcmp(argv[i], "--bins") == 0 && i + 1 < argc)
+            options.bins = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-rally") == 0 && i + 1 < argc)
+            options.maxRally = atof(argv[++i]);
+        else if (strcmp(argv[i], "--max-speed") == 0 && i + 1 < argc)
+            options.maxSpeed = atof(argv[++i]);
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            const char* format = argv[++i];
+            json = strcmp(format, "json") == 0;
+            ok = json || strcmp(format, "csv") == 0;
+        }
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+            outPath = argv[++i];
+        else {
+            std::cout << "Unknown option " << argv[i] << std::endl;
+            PrintUsage();
+            return 1;
+        }
+
+        if (!ok) {
+            std::cout << "Bad value for " << argv[i - 1] << std::endl;
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (options.bins == 0 || options.maxRally <= 0.0 || options.maxSpeed <= 0.0) {
+        std::cout << "Histograms need at least one bin and a positive range" << std::endl;
+        return 1;
+    }
+
+    std::vector<MatchRules> points = SweepPoints(grid);
+    for (const MatchRules& rules : points) {
+        if (rules.ballSize <= 0.0f || rules.paddleLength <= 0.0f || rules.paddleLength >= 2.0f) {
+            std::cout << "Ball sizes and paddle lengths have to be positive and paddles shorter than the screen" << std::endl;
+            return 1;
+        }
+    }
+
+    // progress goes to stderr when the results go to stdout so they can be piped
+    std::ostream& log = outPath ? std::cout : std::cerr;
+    JobSystem jobs(threads);
+    log << "[Sweep] " << points.size() << " points of " << options.matches << " matches on " << jobs.ThreadCount() << " threads" << std::endl;
+
+    double begin = Now();
+    std::vector<SweepStats> stats = RunSweep(points, options, jobs);
+    double seconds = Now() - begin;
+
+    unsigned long long matches = 0;
+    for (const SweepStats& s : stats)
+        matches += s.matches;
+    log << "[Sweep] " << matches << " matches in " << seconds << "s (" << (seconds > 0.0 ? matches / seconds : 0.0) << " matches/s)" << std::endl;
+
+    std::ofstream file;
+    if (outPath) {
+        file.open(outPath);
+        if (!file.is_open()) {
+            std::cout << "[Sweep] couldn't write " << outPath << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = outPath ? (std::ostream&)file : std::cout;
+    if (json)
+        WriteSweepJson(out, points, stats);
+    else
+        WriteSweepCsv(out, points, stats);
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <cstring>
+#include <cstdlib>
+
+#include "JobSystem.h"
+#include "Evolve.h"
+#include "Mlp.h"
+#include "NeuralPolicy.h"
+#include "Tournament.h"
+
+// plays paddle controllers against each other on every core and rates them
+// entrants are idle, tracking, predictive, the path of a network saved with SaveMlp
+// or bot: and an Evolve checkpoint for the best bot in it, e.g.
+//     Tournament --swiss --rounds 6 --matches 200 tracking predictive nets/gen40.mlp bot:bots/tracking.evo
+static void PrintUsage() {
+    std::cout << "Usage: Tournament [--swiss] [--rounds n] [--matches n] [--seed n] [--threads n] [--k f] [--int8] entrant..." << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    TournamentOptions options;
+    unsigned int threads = 0;
+    bool quantize = false;
+    std::vector<const char*> specs;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--swiss") == 0)
+            options.format = TOURNAMENT_SWISS;
+        else if (strcmp(argv[i], "--rounds") == 0 && i + 1 < argc)
+            options.rounds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--matches") == 0 && i + 1 < argc)
+            options.matches = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+            options.seed = (unsigned int)strtoul(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--k") == 0 && i + 1 < argc)
+            options.kFactor = atof(argv[++i]);
+        else if (strcmp(argv[i], "--int8") == 0)
+            quantize = true;
+        else if (argv[i][0] == '-') {
+            std::cout << "Unknown option " << argv[i] << std::endl;
+            PrintUsage();
+            return 1;
+        }
+        else
+            specs.push_back(argv[i]);
+    }
+
+    if (specs.empty()) {
+        specs.push_back("idle");
+        specs.push_back("tracking");
+        specs.push_back("predictive");
+    }
+    if (specs.size() < 2) {
+        std::cout << "A tournament needs at least two entrants" << std::endl;
+        PrintUsage();
+        return 1;
+    }
+
+    // deques so the entrants' pointers stay put as more are loaded
+    std::deque<Mlp> networks;
+    std::deque<BotParams> bots;
+    std::vector<Entrant> entrants;
+    for (const char* spec : specs) {
+        Entrant entrant;
+        entrant.name = spec;
+        if (strncmp(spec, "bot:", 4) == 0) {
+            Evolution evolution;
+            if (!LoadEvolution(spec + 4, evolution) || evolution.population.empty())
+                return 1;
+            bots.push_back(evolution.population.front().params);
+            entrant.kind = POLICY_TUNED;
+            entrant.params = &bots.back();
+        }
+        else if (!ParsePolicyKind(spec, entrant.kind)) {
+            networks.emplace_back();
+            if (!LoadMlp(spec, networks.back()))
+                return 1;
+            if (MlpInputs(networks.back()) != observationCount || MlpOutputs(networks.back()) != 1) {
+                std::cout << spec << " doesn't take " << observationCount << " observations to one move" << std::endl;
+                return 1;
+            }
+            if (quantize)
+                QuantizeMlp(networks.back());
+            entrant.kind = POLICY_NEURAL;
+            entrant.mlp = &networks.back();
+        }
+        entrants.push_back(entrant);
+    }
+
+    JobSystem jobs(threads);
+    std::cout << "[Tournament] " << entrants.size() << " entrants, " << options.rounds << " "
+        << (options.format == TOURNAMENT_SWISS ? "swiss" : "round robin") << " rounds of " << options.matches
+        << " matches a pairing on " << jobs.ThreadCount() << " threads" << std::endl;
+
+    RunTournament(entrants, options, jobs, std::cout);
+    return 0;
+}